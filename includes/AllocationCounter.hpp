@@ -0,0 +1,24 @@
+/**
+ * @file AllocationCounter.hpp
+ * @class AllocationCounter
+ * @brief Counts heap allocations, in benchmark builds.
+ *
+ * Built with FDF_COUNT_ALLOCATIONS (make bench), the global operator new is replaced
+ * by one that allocates through malloc, and the link wraps malloc, calloc and realloc
+ * (-Wl,--wrap) with counting versions, so allocations made by C code such as MLX42 are
+ * counted too and frames can be checked to allocate nothing. Otherwise the count stays
+ * at zero and isEnabled() is false.
+ */
+
+#ifndef ALLOCATIONCOUNTER_HPP
+# define ALLOCATIONCOUNTER_HPP
+
+# include <cstddef>
+
+class AllocationCounter{
+	public:
+		static bool isEnabled();
+		static size_t getCount();
+};
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * @file Benchmark.hpp
+ * @class Benchmark
+ * @brief Times the frame loop and checks that steady frames do not allocate.
+ *
+ * Measures the hooks run for each frame, after a few warm-up frames that fill the
+ * caches and scratch buffers. In builds with allocation counting (make bench), the
+ * benchmark fails if any measured frame allocated.
+ */
+
+#ifndef BENCHMARK_HPP
+# define BENCHMARK_HPP
+
+# include <chrono>
+# include <cstddef>
+
+class Benchmark{
+	public:
+		static constexpr int WARMUP_FRAMES = 10;
+		static constexpr int DEFAULT_FRAMES = 300;
+
+	private:
+		int _frames;
+		int _frame;
+		std::chrono::steady_clock::time_point _start;
+		size_t _startAllocations;
+		double _totalMs;
+		double _worstMs;
+		size_t _allocations;
+		int _allocatingFrames;
+
+	public:
+		Benchmark(int frames = DEFAULT_FRAMES);
+		~Benchmark();
+
+		void beginFrame();
+		void endFrame();
+		bool isDone() const;
+		bool hasPassed() const;
+		void report() const;
+};
+
+#endif
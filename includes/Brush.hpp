@@ -0,0 +1,70 @@
+/**
+ * @class Brush
+ * @brief Computes terrain sculpting strokes around a grid vertex.
+ *
+ * A stroke raises, lowers or smooths the heights within the brush radius, with
+ * a falloff that fades the effect out toward the rim. The result is a
+ * rectangle of new heights, ready for HeightMap::updateRegion(), so only the
+ * touched area is recomputed. The brush owns its scratch buffer, so strokes do
+ * not allocate once the largest radius has been used.
+ */
+
+#ifndef BRUSH_HPP
+# define BRUSH_HPP
+
+# include <vector>
+# include "HeightMap.hpp"
+
+class Brush {
+    public:
+        enum Mode {
+            OFF,
+            RAISE,
+            LOWER,
+            SMOOTH,
+            MODE_COUNT
+        };
+
+        /**
+         * @brief Rectangle of heights produced by one stroke.
+         *
+         * heights holds width * height values, row-major, and stays valid until
+         * the next stroke. minZ and maxZ span both the old and the new heights,
+         * so the area's screen footprint before and after the stroke is enclosed.
+         */
+        struct Stroke {
+            int x0;
+            int y0;
+            int width;
+            int height;
+            int minZ;
+            int maxZ;
+            const int *heights;
+        };
+
+        static constexpr int MIN_RADIUS = 1;
+        static constexpr int MAX_RADIUS = 256;
+        static constexpr int DEFAULT_RADIUS = 8;
+        static constexpr double STRENGTH = 1.0 / 128;
+
+    private:
+        Mode _mode;
+        int _radius;
+        std::vector<int> _patch;
+
+        int sculptedHeight(const HeightMap &heightMap, int x, int y, double weight, double step) const;
+
+    public:
+        Brush();
+        ~Brush();
+
+        void cycleMode();
+        Mode getMode() const;
+        const char *getModeName() const;
+        void setRadius(int radius);
+        int getRadius() const;
+
+        bool stroke(const HeightMap &heightMap, int x, int y, Stroke &result);
+};
+
+#endif
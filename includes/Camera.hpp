@@ -13,18 +13,59 @@
 #include "MLXHandler.hpp"
 #include "projections/Projector.hpp"
 #include "HeightMap.hpp"
+#include <cmath>
+
+/**
+ * @brief Axis-aligned screen region, inclusive of x0/y0 and exclusive of x1/y1.
+ */
+struct ScreenRect {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+};
+
+/**
+ * @brief Grid point after spacing, Z scaling and rotation, ready to be projected.
+ */
+struct CameraPoint {
+    int x;
+    int y;
+    int z;
+};
 
 class Camera {
     private:
+        /**
+         * @brief Cached 2D bounds of the unrotated projected map for one projection.
+         *
+         * Valid while the spacing and Z factor it was computed with are unchanged.
+         */
+        struct ProjectedBounds {
+            bool valid;
+            double spacing;
+            double zFactor;
+            int minX;
+            int minY;
+            int maxX;
+            int maxY;
+        };
+
+
         double _zoomLevel;
         int _cameraX;
         int _cameraY;
+        int _panX;
+        int _panY;
         int _horizontalOffset;
         int _verticalOffset;
         double _spacing;
         double _rotationAngleX;
         double _rotationAngleY;
         double _rotationAngleZ;
+        double _cosX, _sinX;
+        double _cosY, _sinY;
+        double _cosZ, _sinZ;
         MLXHandler &_MLXHandler;
         Projector *_projector;
         HeightMap &_heightMap;
@@ -39,6 +80,15 @@ class Camera {
         double _OriginalRotationAngleY;
         double _OriginalRotationAngleZ;
 
+        ProjectedBounds _boundsCache[Projector::PROJECTION_COUNT];
+
+        const ProjectedBounds &getProjectedBounds();
+        void computeProjectedBounds(ProjectedBounds &bounds) const;
+        template <typename P>
+        void computeProjectedBounds(const P &projection, ProjectedBounds &bounds) const;
+        double fittedSpacing() const;
+        void updateRotation();
+
     public:
         Camera(MLXHandler &MLXHandler, Projector *projector, HeightMap &heightMap);
         ~Camera();
@@ -48,6 +98,7 @@ class Camera {
         void centerCamera();
         void calculateOffset();
         void calculateInitialScale();
+        void fitHeightMap();
         void rotateX(double angle);
         void rotateY(double angle);
         void rotateZ(double angle);
@@ -61,10 +112,178 @@ class Camera {
         double getRotationAngleX() const;
         double getRotationAngleY() const;
         double getRotationAngleZ() const;
+        Projector *getProjector() const;
 
         std::pair<int, int> worldToScreen(int x, int y, int z) const;
+        template <typename P>
+        std::pair<int, int> worldToScreen(const P &projection, int x, int y, int z) const;
+        CameraPoint toCameraSpace(double x, double y, int z) const;
+        template <typename P>
+        std::pair<int, int> cameraToScreen(const P &projection, const CameraPoint &point) const;
+        template <typename P>
+        bool isInFront(const P &projection, const CameraPoint &point) const;
+        template <typename P>
+        CameraPoint clipToNearPlane(const P &projection, const CameraPoint &front, const CameraPoint &behind) const;
+        bool boxScreenRect(int x0, int y0, int z0, int x1, int y1, int z1, ScreenRect &rect) const;
+        bool isBoxInRect(int x0, int y0, int z0, int x1, int y1, int z1, int margin, const ScreenRect &rect) const;
 
         void reset();
+        void invalidateBounds();
 };
 
+/**
+ * @brief Transforms world coordinates to screen-space using projection and camera state.
+ * 
+ * Applies spacing, Z scaling, rotation (X, Y, Z), and current zoom/pan values to
+ * convert a 3D point in the heightmap into its final 2D screen position.
+ *
+ * Instantiated per projection type so the projection math is inlined into the
+ * caller's loop; use the non-template overload for one-off points.
+ *
+ * @param projection Concrete projection to apply.
+ * @param x X coordinate in the height map grid.
+ * @param y Y coordinate in the height map grid.
+ * @param z Raw height value (Z-axis) at the given grid point.
+ * @return A pair of integers representing the screen X and Y coordinates.
+ */
+template <typename P>
+std::pair<int, int> Camera::worldToScreen(const P &projection, int x, int y, int z) const {
+    return cameraToScreen(projection, toCameraSpace(x, y, z));
+}
+
+/**
+ * @brief Moves a grid point into camera space.
+ *
+ * Applies spacing and Z scaling, then rotates around the map center using the
+ * sines and cosines cached when the rotation last changed. Grid coordinates may
+ * be fractional, for points between vertices such as contour crossings.
+ *
+ * @param x X coordinate in the height map grid.
+ * @param y Y coordinate in the height map grid.
+ * @param z Raw height value at the given grid point.
+ * @return The point as handed to the projection.
+ */
+inline CameraPoint Camera::toCameraSpace(double x, double y, int z) const {
+    int drawX = x * _spacing;
+    int drawY = y * _spacing;
+    int drawZ = z * _heightMap.getZFactor();
+    
+    int centerX = _heightMap.getMatrixWidth() / 2 * _spacing;
+    int centerY = _heightMap.getMatrixHeight() / 2 * _spacing;
+    int centerZ = 0;
+
+    drawX -= centerX;
+    drawY -= centerY;
+    drawZ -= centerZ;
+    
+    int originalX = drawX;
+    int originalY = drawY;
+    int originalZ = drawZ;
+
+    if (_rotationAngleX != 0.0) {
+        drawY = round(originalY * _cosX - originalZ * _sinX);
+        drawZ = round(originalY * _sinX + originalZ * _cosX);
+        
+        originalY = drawY;
+        originalZ = drawZ;
+    }
+    
+    if (_rotationAngleY != 0.0) {
+        drawX = round(originalX * _cosY + originalZ * _sinY);
+        drawZ = round(-originalX * _sinY + originalZ * _cosY);
+        
+        originalX = drawX;
+    }
+    
+    if (_rotationAngleZ != 0.0) {
+        drawX = round(originalX * _cosZ - originalY * _sinZ);
+        drawY = round(originalX * _sinZ + originalY * _cosZ);
+    }
+
+    return {drawX + centerX, drawY + centerY, drawZ + centerZ};
+}
+
+/**
+ * @brief Projects a camera-space point and applies offsets, zoom and pan.
+ *
+ * Perspective-family projections expect the point to be in front of their near
+ * plane; see isInFront() and clipToNearPlane().
+ *
+ * @param projection Concrete projection to apply.
+ * @param point Point returned by toCameraSpace() or clipToNearPlane().
+ * @return Screen X and Y coordinates.
+ */
+template <typename P>
+std::pair<int, int> Camera::cameraToScreen(const P &projection, const CameraPoint &point) const {
+    std::pair<int, int> projectedPoint = projection.project(point.x, point.y, point.z);
+    
+    int centeredX = projectedPoint.first + _horizontalOffset;
+    int centeredY = projectedPoint.second + _verticalOffset;
+    
+    int screenCenterX = _MLXHandler.getWidth() / 2;
+    int screenCenterY = _MLXHandler.getHeight() / 2;
+    
+    int screenX = screenCenterX + ((centeredX - screenCenterX) - _cameraX) * _zoomLevel;
+    int screenY = screenCenterY + ((centeredY - screenCenterY) - _cameraY) * _zoomLevel;
+    
+    return {screenX + _panX, screenY + _panY};
+}
+
+/**
+ * @brief Tells whether a camera-space point lies on the visible side of the near plane.
+ *
+ * Always true for projections without depth, where the check compiles away.
+ *
+ * @param projection Concrete projection the point will be projected with.
+ * @param point Camera-space point.
+ * @return False if the point is behind the viewer or too close to project.
+ */
+template <typename P>
+bool Camera::isInFront(const P &projection, const CameraPoint &point) const {
+    if constexpr (P::HAS_DEPTH)
+        return projection.depth(point.x, point.y, point.z) >= projection.nearDepth();
+    (void)projection;
+    (void)point;
+    return true;
+}
+
+/**
+ * @brief Finds where an edge crosses the near plane.
+ *
+ * Bisects the camera-space segment on the projection's depth, which also covers
+ * depths that are not linear along the segment.
+ *
+ * @param projection Concrete projection providing depth() and nearDepth().
+ * @param front Endpoint in front of the near plane.
+ * @param behind Endpoint behind it.
+ * @return The last point of the segment found in front of the near plane.
+ */
+template <typename P>
+CameraPoint Camera::clipToNearPlane(const P &projection, const CameraPoint &front, const CameraPoint &behind) const {
+    if constexpr (!P::HAS_DEPTH) {
+        (void)projection;
+        (void)behind;
+        return front;
+    } else {
+        double nearDepth = projection.nearDepth();
+        double inside = 0.0;
+        double outside = 1.0;
+
+        for (int i = 0; i < 16; i++) {
+            double t = (inside + outside) / 2;
+            double depth = projection.depth(front.x + (behind.x - front.x) * t,
+                                            front.y + (behind.y - front.y) * t,
+                                            front.z + (behind.z - front.z) * t);
+            if (depth >= nearDepth)
+                inside = t;
+            else
+                outside = t;
+        }
+
+        return {static_cast<int>(lround(front.x + (behind.x - front.x) * inside)),
+                static_cast<int>(lround(front.y + (behind.y - front.y) * inside)),
+                static_cast<int>(lround(front.z + (behind.z - front.z) * inside))};
+    }
+}
+
 #endif
\ No newline at end of file
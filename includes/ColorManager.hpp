@@ -3,7 +3,8 @@
  * @brief Manages color selection and interpolation based on height values.
  *
  * Provides a way to color heightmap points by interpolating between predefined
- * color palettes. Also supports custom per-point colors defined in the HeightMap.
+ * color palettes. Also supports custom per-point colors defined in the HeightMap,
+ * and an optional hillshading term lit by a directional sun.
  */
  
 #ifndef COLOR_MANAGER_HPP
@@ -11,6 +12,7 @@
 
 #include <cstdint>
 #include <algorithm>
+#include <vector>
 #include "HeightMap.hpp"
 
 class ColorManager {
@@ -98,8 +100,25 @@ class ColorManager {
 
         static constexpr int COLOR_COUNT = 10;
 
+        static constexpr float AMBIENT_LIGHT = 0.35f;
+
         const uint32_t* _selectedColors;
         int _currentColorSet;
+
+        bool _equalized;
+        bool _lighting;
+        double _lightAzimuth;
+        double _lightAltitude;
+        std::vector<uint8_t> _shades;
+        bool _shadesValid;
+        double _shadedZFactor;
+        int _dirtyX0;
+        int _dirtyY0;
+        int _dirtyX1;
+        int _dirtyY1;
+
+        void updateShades(int x0, int y0, int x1, int y1);
+        int applyShade(int color, int x, int y);
     
     public:
         ColorManager(HeightMap &heightMap);
@@ -137,6 +156,15 @@ class ColorManager {
             return _currentColorSet;
         }
 
+        void setEqualizedStatus(bool status);
+        bool getEqualizedStatus() const;
+        void setLightingStatus(bool status);
+        bool getLightingStatus() const;
+        void rotateLight(double angle);
+        void invalidateShades();
+        void invalidateShades(int x0, int y0, int x1, int y1);
+        double getLightAzimuth() const;
+
         int getColorFromHeight(int x, int y, int z);
         int interpolateColor(int color1, int color2, float t);
 };
@@ -0,0 +1,62 @@
+/**
+ * @class Contours
+ * @brief Extracts and caches contour lines (isolines) of a height map.
+ *
+ * Traces marching squares over every grid cell at each multiple of the contour
+ * interval. Segments are stored in grid space, grouped by the HeightMap chunk
+ * their cell belongs to, and only regenerated when the interval changes or the
+ * cache is invalidated.
+ */
+
+#ifndef CONTOURS_HPP
+# define CONTOURS_HPP
+
+# include <vector>
+# include "HeightMap.hpp"
+
+class Contours {
+    public:
+        /**
+         * @brief Piece of a contour line crossing one grid cell.
+         *
+         * Endpoints are fractional grid coordinates; z is the contour level as a
+         * raw height.
+         */
+        struct Segment {
+            float x0;
+            float y0;
+            float x1;
+            float y1;
+            int z;
+        };
+
+    private:
+        HeightMap &_heightMap;
+        int _interval;
+        bool _userInterval;
+        bool _valid;
+        std::vector<Segment> _segments;
+        std::vector<int> _chunkOffsets;
+        std::vector<std::vector<Segment>> _bands;
+        std::vector<int> _counts;
+
+        void build();
+        void traceChunk(const HeightMap::Chunk &chunk, std::vector<Segment> &out) const;
+        void traceCell(int x, int y, std::vector<Segment> &out) const;
+
+    public:
+        Contours(HeightMap &heightMap);
+        ~Contours();
+
+        void fitInterval();
+        void setInterval(int interval);
+        int getInterval() const;
+        void invalidate();
+
+        void update();
+        const std::vector<Segment> &getSegments() const;
+        int getChunkBegin(int chunk) const { return _chunkOffsets[chunk]; }
+        int getChunkEnd(int chunk) const { return _chunkOffsets[chunk + 1]; }
+};
+
+#endif
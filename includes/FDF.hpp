@@ -3,7 +3,7 @@
  * @brief Core rendering controller for the FDF++ application.
  *
  * Responsible for linking the rendering pipeline components (HeightMap, Projector,
- * Camera, VFX, Renderer, ColorManager), and exposing interaction methods such as
+ * Camera, VFX, Renderer, ColorManager, Contours), and exposing interaction methods such as
  * zooming, rotating, and drawing the map.
  */
 
@@ -13,6 +13,8 @@
 #include "HeightMap.hpp"
 #include "Camera.hpp"
 #include "ColorManager.hpp"
+#include "Contours.hpp"
+#include "Brush.hpp"
 #include "Renderer.hpp"
 #include "projections/Projector.hpp"
 #include "MLXHandler.hpp"
@@ -25,24 +27,33 @@ class FDF {
         VFX *_vfx;
         Camera _camera;
         ColorManager _colorManager;
+        Contours _contours;
         Renderer _renderer;
 
     public:
-        FDF(std::vector<std::string> &map, Projector *projector, MLXHandler &MLXHandler, VFX *vfx);
+        FDF(const std::vector<std::string_view> &map, Projector *projector, MLXHandler &MLXHandler, VFX *vfx,
+            std::optional<int> noDataValue = std::nullopt, LoadArena *text = NULL);
+        FDF(HeightMap &&heightMap, Projector *projector, MLXHandler &MLXHandler, VFX *vfx);
         ~FDF();
         
         void draw();
+        void drawPanned(int dx, int dy);
         
         void zoom(double factor, int mouseX, int mouseY);
         void pan(int dx, int dy);
         void centerCamera();
         void setZFactor(double increase, int mode);
+        void updateRegion(int x0, int y0, int width, int height, const int *heights, size_t stride);
+        void setHeightMap(HeightMap &&heightMap);
+        bool sculpt(Brush &brush, int screenX, int screenY);
         
         Projector *getProjector();
         Camera *getCamera();
         VFX *getVFX();
         HeightMap *getHeightMap();
         ColorManager *getColorManager();
+        Contours *getContours();
+        Renderer *getRenderer();
         double getZFactor();
         std::vector<std::vector<int>> &getMatrix();
 
@@ -12,13 +12,70 @@
 
 # include <vector>
 # include <string>
+# include <string_view>
 # include <sstream>
 # include <climits>
 # include <algorithm>
+# include <cstdint>
+# include <optional>
 # include "mapHandler/Map.hpp"
+# include "mapHandler/LoadArena.hpp"
 
 class HeightMap {
-private:
+    public:
+        /**
+         * @brief Rectangular block of grid vertices with a cached height range.
+         *
+         * A chunk owns the vertices in [x0, xEnd) x [y0, yEnd) and the edges that
+         * start on them; the edges starting on its row r are
+         * [edgeRows[rowBegin + r], edgeRows[rowBegin + r + 1]). Its bounding box reaches one vertex further (xMax, yMax)
+         * so the edges leaving the chunk to the right and bottom are enclosed too.
+         * Chunks are stored row-major, getChunkColumns() per row.
+         * Heights are stored unscaled; apply the Z factor when projecting. The height
+         * range ignores no-data vertices, and noDataCount counts the owned ones.
+         */
+        struct Chunk {
+            int x0;
+            int y0;
+            int xEnd;
+            int yEnd;
+            int xMax;
+            int yMax;
+            int minZ;
+            int maxZ;
+            int edgeBegin;
+            int edgeEnd;
+            int rowBegin;
+            int noDataCount;
+        };
+
+        /**
+         * @brief Grid edge stored as two indices into its chunk's vertex block.
+         *
+         * The block spans [x0, xMax] x [y0, yMax] row-major, so an index i maps to
+         * grid (x0 + i % blockWidth, y0 + i / blockWidth).
+         */
+        struct Edge {
+            uint16_t from;
+            uint16_t to;
+        };
+
+        /**
+         * @brief Height change per grid step along X and Y at a vertex.
+         *
+         * Central differences, one-sided at the border and next to no-data cells.
+         * The surface normal for a Z factor k is (-k * dx, -k * dy, 1), normalized.
+         */
+        struct Slope {
+            float dx;
+            float dy;
+        };
+
+        static const int CHUNK_SIZE = 64;
+        static const int HISTOGRAM_BINS = 65536;
+        static_assert((CHUNK_SIZE + 1) * (CHUNK_SIZE + 1) <= 65536, "Edge indices must fit in 16 bits");
+
+    private:
         Map _map;
         std::vector<std::vector<int>> _matrix;
         int _matrixHeight;
@@ -26,15 +83,46 @@ private:
         int _minHeight;
         int _maxHeight;
         double _zFactor;
+        std::optional<int> _noDataValue;
+        std::vector<bool> _noDataMask;
 
         int _nPoints;
 		int _nEdges;
+
+        std::vector<Chunk> _chunks;
+        std::vector<Edge> _edges;
+        std::vector<int> _edgeRows;
+        std::vector<Slope> _slopes;
+        std::vector<int> _histogram;
+        std::vector<int> _bandHistograms;
+        std::vector<float> _equalized;
+        long _binWidth;
+        int _chunkColumns;
+        int _chunkRows;
         
-        void parseMapLine(const std::string &line, std::vector<Map::MapPoint> &points);
+        static int countPoints(std::string_view line);
+        static void parseMapLine(std::string_view line, Map::MapPoint *points);
+        void initialize();
         void calculateMinMaxHeight();
+        void calculateMinMaxFromChunks();
+        void buildNoDataMask();
+        void buildChunks();
+        void measureChunk(Chunk &chunk);
+        void buildEdgeList();
+        void buildEdges(Chunk &chunk);
+        void buildSlopes();
+        Slope computeSlope(int x, int y) const;
+        void buildHistogram();
+        int histogramBin(int z) const;
+        void buildEqualization();
 
     public:
-        HeightMap(std::vector<std::string> &map);
+        HeightMap(const std::vector<std::string_view> &map, std::optional<int> noDataValue = std::nullopt,
+                  LoadArena *text = NULL);
+        HeightMap(int width, int height, const std::vector<int> &heights,
+                  std::optional<int> noDataValue = std::nullopt);
+        HeightMap(HeightMap &&other) = default;
+        HeightMap &operator=(HeightMap &&other) = default;
         ~HeightMap();
         
         std::vector<std::vector<int>> &getMatrix() { return _matrix; }
@@ -43,9 +131,21 @@ private:
         int getZ(int x, int y) const;
         int getColor(int x, int y) const;
         bool hasCustomColor(int x, int y) const;
+        int getMinHeight() const;
+        int getMaxHeight() const;
         float normalizeHeight(int z) const;
+        float equalizeHeight(int z) const;
         void setZFactor(double factor, int mode);
+        void updateRegion(int x0, int y0, int width, int height, const int *heights, size_t stride);
         double getZFactor() const;
+        const std::vector<Chunk> &getChunks() const;
+        const std::vector<Edge> &getEdges() const;
+        const std::vector<int> &getEdgeRows() const;
+        int getChunkColumns() const;
+        int getChunkRows() const;
+        bool isNoData(int x, int y) const { return _noDataMask[static_cast<size_t>(y) * _matrixWidth + x]; }
+        std::optional<int> getNoDataValue() const;
+        const Slope &getSlope(int x, int y) const { return _slopes[static_cast<size_t>(y) * _matrixWidth + x]; }
         
         int getNPoints() const;
         int getNEdges() const;
@@ -13,9 +13,17 @@
 # include <iostream>
 # include <stdexcept>
 # include <cstring> 
+# include <future>
+# include "Brush.hpp"
 # include "../libs/mlx42/include/MLX42/MLX42.h"
 
 class FDF;
+class HeightMap;
+class UI;
+class MapLoader;
+class HeightStream;
+class FrameSequence;
+class Benchmark;
 
 class MLXHandler{
 	private:
@@ -34,13 +42,25 @@ class MLXHandler{
 		mlx_image_t *_text2;
 
 		FDF *_fdf;
+		UI *_overlay;
+		MapLoader *_loader;
+		HeightStream *_stream;
+		FrameSequence *_sequence;
+		Benchmark *_benchmark;
+		size_t _previewRows;
+		std::future<HeightMap *> _nextHeightMap;
+		bool _nextIsFinal;
 		bool _autoRotate;
+		Brush _brush;
+		bool _sculptStale;
 
 		bool _leftMousePressed;
 		bool _rightMousePressed;
 		int _lastMouseX;
 		int _lastMouseY;
 
+		void inspect(int32_t mouseX, int32_t mouseY, bool print);
+
 	public:
 		MLXHandler(int width, int height, const char* title);
 		MLXHandler(const MLXHandler &other);
@@ -62,12 +82,22 @@ class MLXHandler{
 
 		void setAutoRotate(bool autoRotate);
 		void setFDF(FDF *fdf);
+		void setOverlay(UI *overlay);
+		void setLoader(MapLoader *loader);
+		void setStream(HeightStream *stream);
+		void setSequence(FrameSequence *sequence);
+		void setBenchmark(Benchmark *benchmark);
 
 		void render() const;
 		void handleEvents();
 		void clearImage(mlx_image_t *img);
 		void cleanup();
 
+		static void frameStartHook(void *param);
+		static void frameEndHook(void *param);
+		static void loadHook(void *param);
+		static void streamHook(void *param);
+		static void playHook(void *param);
 		static void basicHooks(void *param);
 		static void scrollHook(double xdelta, double ydelta, void *param);
 		static void perspectiveHooks(void *param);
@@ -13,29 +13,155 @@
 #include "HeightMap.hpp"
 #include "Camera.hpp"
 #include "ColorManager.hpp"
+#include "Contours.hpp"
+#include "mapHandler/TiledMap.hpp"
 #include "VFX.hpp"
 
 class Renderer {
 private:
+    /**
+     * @brief Chunk vertex transformed once per frame and shared by its edges.
+     */
+    struct ProjectedVertex {
+        CameraPoint camera;
+        std::pair<int, int> screen;
+        int x;
+        int y;
+        int z;
+        int color;
+        float depth;
+        bool valid;
+        bool inFront;
+    };
+
+    /**
+     * @brief Front-most vertex drawn inside one cell of the screen-space pick index.
+     */
+    struct PickCell {
+        int vertex;
+        float depth;
+        int screenX;
+        int screenY;
+    };
+
+    /**
+     * @brief Direction in which grid columns and rows are walked.
+     */
+    struct Traversal {
+        bool reverseX;
+        bool reverseY;
+    };
+
     MLXHandler &_MLXHandler;
     HeightMap &_heightMap;
     Camera &_camera;
     ColorManager &_colorManager;
+    Contours &_contours;
     VFX *_vfx;
     float _time;
+    ScreenRect _clip;
+    std::vector<ProjectedVertex> _vertices;
+    bool _depthTest;
+    std::vector<float> _depthBuffer;
+    bool _fillStatus;
+    bool _contourStatus;
+    TiledMap *_tiledMap;
+    int _overviewLevel;
+    std::vector<ProjectedVertex> _tileVertices;
+    bool _inspectStatus;
+    bool _sculptStatus;
+    bool _pickStatus;
+    bool _pickIndexValid;
+    int _pickColumns;
+    std::vector<PickCell> _pickIndex;
+
+    static const int CULL_MARGIN = 4;
+    static const int MAX_SUBDIVISION = 6;
+    static const int PICK_RADIUS = 6;
+    static const int PICK_CELL = 8;
+    static_assert(PICK_CELL > PICK_RADIUS, "A pick must only reach the neighboring index cells");
+    static constexpr uint32_t CONTOUR_COLOR = 0xF0F0F0FF;
+    static constexpr uint32_t CONTOUR_COLOR_ON_FILL = 0x202020FF;
+    static constexpr double DETAIL_CELL_PIXELS = 4.0;
     
 public:
     Renderer(MLXHandler &MLXHandler, HeightMap &heightMap, Camera &camera, 
-             ColorManager &colorManager, VFX *vfx);
+             ColorManager &colorManager, Contours &contours, VFX *vfx);
     ~Renderer();
     
     void draw();
+    void drawScrolled(int shiftX, int shiftY);
+    void redrawGridBox(int x0, int y0, int x1, int y1, int z0, int z1);
+    bool pickVertex(int screenX, int screenY, int &x, int &y) const;
+
+    void setDepthTestStatus(bool status);
+    bool getDepthTestStatus() const;
+    void setFillStatus(bool status);
+    bool getFillStatus() const;
+    void setContourStatus(bool status);
+    bool getContourStatus() const;
+    void setTiledMap(TiledMap *tiledMap, int overviewLevel);
+    TiledMap *getTiledMap() const;
+    void setInspectStatus(bool status);
+    bool getInspectStatus() const;
+    void setSculptStatus(bool status);
     
 private:
-    void drawPoints();
-    void drawLines();
+    void drawMap();
+    template <typename P>
+    bool pickVertex(const P &projection, int screenX, int screenY, int &x, int &y) const;
+    template <typename P>
+    void drawPoints(const P &projection);
+    template <typename P>
+    void drawLines(const P &projection);
+    template <typename P>
+    void drawSurface(const P &projection);
+    template <typename P>
+    void drawContours(const P &projection, int chunk);
+    int detailLevel(const HeightMap::Chunk &chunk) const;
+    template <typename P>
+    void drawDetail(const P &projection, const HeightMap::Chunk &chunk, int level, const Traversal &traversal);
+    template <typename P>
+    void projectTile(const P &projection, const int32_t *samples, int vx0, int vy0, int vx1, int vy1, int scale);
+    template <typename F>
+    void forEachChunk(const Traversal &traversal, F visit);
+    template <typename P>
+    Traversal backToFront(const P &projection) const;
+    template <typename P>
+    void drawGridEdge(const P &projection, int index);
+    template <typename P>
+    void drawVertexEdge(const P &projection, const ProjectedVertex &a, const ProjectedVertex &b);
+    template <typename P>
+    void projectChunk(const P &projection, const HeightMap::Chunk &chunk);
+    template <typename P>
+    bool clipEdge(const P &projection, CameraPoint &from, bool fromInFront, CameraPoint &to, bool toInFront,
+                  std::pair<int, int> &start, std::pair<int, int> &end);
+    template <typename P>
+    void drawEdge(const P &projection, const CameraPoint &from, const CameraPoint &to,
+                  std::pair<int, int> start, std::pair<int, int> end, int startColor, int endColor);
+    template <typename P>
+    void drawCurvedEdge(const P &projection, const CameraPoint &from, const CameraPoint &to,
+                        std::pair<int, int> start, std::pair<int, int> end,
+                        int startColor, int endColor, int level);
+    template <typename P>
+    void drawSegment(const P &projection, const CameraPoint &from, const CameraPoint &to,
+                     std::pair<int, int> start, std::pair<int, int> end, int startColor, int endColor);
+    void applyEffects(std::pair<int, int> &point);
+    bool isChunkVisible(const HeightMap::Chunk &chunk, int margin) const;
+    bool isEdgeVisible(std::pair<int, int> a, std::pair<int, int> b);
+    void scrollImage(int shiftX, int shiftY);
+    void scrollBuffer(uint8_t *data, size_t stride, size_t cellSize, int shiftX, int shiftY);
+    void clearDepth(const ScreenRect &rect);
+    void updatePickStatus();
+    void clearPickIndex(const ScreenRect &rect);
+    void recordPick(int x, int y, std::pair<int, int> screen, float depth);
+    bool lookupPickIndex(int screenX, int screenY, int &x, int &y) const;
+    void redrawRect(const ScreenRect &rect);
     void drawLineSafeWithGradient(std::pair<int, int> start, std::pair<int, int> end, 
                                   int startColor, int endColor);
+    void drawLineDepthTested(std::pair<int, int> start, std::pair<int, int> end,
+                             int startColor, int endColor, float startDepth, float endDepth);
+    void fillTriangle(const ProjectedVertex &a, const ProjectedVertex &b, const ProjectedVertex &c);
 };
 
 #endif
\ No newline at end of file
@@ -27,10 +27,18 @@ class UI {
 		std::vector<std::string> _controls;
 		std::vector<std::string> _controls2;
 		int _controlsOffset;
+		size_t _brushLine;
+		size_t _inspectLine;
+		std::string _inspection;
+		mlx_image_t *_inspectText;
 
 		std::string _nPoints;
 		std::string _nEdges;
-		
+
+		static const int GLYPH_WIDTH = 10;
+
+		void outputLine(size_t line);
+		void putText(mlx_image_t *&image, const std::string &text, int x, int y, size_t capacity);
 
 	public:
 		UI(HeightMap *heightMap, MLXHandler *mlxhandler, int uiWidth, int uiHeight);
@@ -40,6 +48,10 @@ class UI {
 		void fillBackground();
 		void ColorText(mlx_image_t *img, uint8_t targetR, uint8_t targetG, uint8_t targetB);
 		void outputControls();
+		void setHeightMap(HeightMap *heightMap);
+		void setBrushStatus(const std::string &mode, int radius);
+		void setInspection(int x, int y, int z, uint32_t color);
+		void clearInspection();
 		void clearTexts();
 };
 
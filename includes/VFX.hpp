@@ -15,6 +15,7 @@
 
 class VFX{
 	private:
+		std::minstd_rand _generator;
 		float _jitterIntensity;
 		float _vortexDistortionIntensity;
 
@@ -37,6 +38,8 @@ class VFX{
 	bool &getPulseWaveStatus();
 	bool &getVortexDistortionStatus();
 	bool &getChromaticAberrationStatus();
+	int getMaxDisplacement() const;
+	bool isActive() const;
 
 	void setJitterIntensity(float intensity);
 	void setvortexDistortionIntensity(float intensity);
@@ -48,12 +51,12 @@ class VFX{
 	void setChromaticAberrationStatus(bool status);
 	
 
-	std::pair<int, int> jitter(std::pair<int, int> point);
-	std::pair<int, int> waveDistortion(std::pair<int, int> point, float time);
-	std::pair<int, int> glitch(std::pair<int, int> point);
-	std::pair<int, int> pulseWave(std::pair<int, int> point, float time, int centerX, int centerY);
-	std::pair<int, int> vortexDistortion(std::pair<int, int> point, float time, int centerX, int centerY);
-	std::pair<int, int> chromaticAberration(std::pair<int, int> point, int channelOffset);
+	void jitter(std::pair<int, int> &point);
+	void waveDistortion(std::pair<int, int> &point, float time) const;
+	void glitch(std::pair<int, int> &point);
+	void pulseWave(std::pair<int, int> &point, float time, int centerX, int centerY) const;
+	void vortexDistortion(std::pair<int, int> &point, float time, int centerX, int centerY) const;
+	void chromaticAberration(std::pair<int, int> &point, int channelOffset) const;
 };
 
 #endif
\ No newline at end of file
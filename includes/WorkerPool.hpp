@@ -0,0 +1,67 @@
+/**
+ * @file WorkerPool.hpp
+ * @class WorkerPool
+ * @brief Persistent threads for the bands of per-frame parallel loops.
+ *
+ * Shading, histogram and contour updates can run every frame while heights change.
+ * Spawning threads for them would allocate and add startup latency each time, so they
+ * hand their bands to threads started once instead. Tasks are called through a plain
+ * function pointer, so dispatching a job allocates nothing.
+ */
+
+#ifndef WORKERPOOL_HPP
+# define WORKERPOOL_HPP
+
+# include <atomic>
+# include <condition_variable>
+# include <cstddef>
+# include <mutex>
+# include <thread>
+# include <vector>
+
+class WorkerPool{
+	private:
+		typedef void (*Task)(void *context, int band);
+
+		std::vector<std::thread> _threads;
+		std::mutex _mutex;
+		std::mutex _busy;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+
+		Task _task;
+		void *_context;
+		int _bands;
+		std::atomic<int> _nextBand;
+		int _running;
+		size_t _generation;
+		bool _stop;
+
+		WorkerPool();
+		WorkerPool(const WorkerPool &other);
+		WorkerPool &operator=(const WorkerPool &other);
+
+		void dispatch(int bands, Task task, void *context);
+		void runBands();
+		void work();
+
+	public:
+		~WorkerPool();
+
+		static WorkerPool &shared();
+		int getThreadCount() const;
+
+		/**
+		 * @brief Calls task(band) for every band in [0, bands), spread over the pool.
+		 *
+		 * The calling thread takes bands too, and returns once all are done.
+		 * If the pool is busy with another caller's job, the bands run on the
+		 * calling thread instead of waiting.
+		 */
+		template <typename F>
+		void run(int bands, F &task) {
+			dispatch(bands, [](void *context, int band) { (*static_cast<F *>(context))(band); }, &task);
+		}
+};
+
+#endif
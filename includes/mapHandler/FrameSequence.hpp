@@ -0,0 +1,92 @@
+/**
+# * @file FrameSequence.hpp
+# * @class FrameSequence
+# * @brief Plays a sequence of .fdf map files of the same grid size as an animation.
+# *
+# * The frames are the .fdf files of a directory, or the files matching a glob pattern,
+# * in name order. A reader thread parses them ahead, in a loop, into a ring of
+# * preallocated grids; the renderer takes them at a fixed frame rate. Each frame carries
+# * the rectangle that differs from the previous one, so consumers can update only that
+# * part of their copy. Per-point colors are dropped. Includes custom exceptions for
+# * error handling.
+# */
+
+#ifndef FRAMESEQUENCE_HPP
+# define FRAMESEQUENCE_HPP
+
+# include <atomic>
+# include <chrono>
+# include <condition_variable>
+# include <cstddef>
+# include <exception>
+# include <mutex>
+# include <string>
+# include <thread>
+# include <vector>
+
+class FrameSequence{
+	public:
+		/**
+		 * @brief Rectangle of grid cells changed by a frame; x1 and y1 are exclusive.
+		 */
+		struct Region {
+			int x0;
+			int y0;
+			int x1;
+			int y1;
+		};
+
+		static constexpr size_t RING_SIZE = 4;
+		static constexpr int DEFAULT_FPS = 24;
+		static constexpr int MAX_FPS = 240;
+
+	private:
+		FrameSequence(const FrameSequence &other);
+		FrameSequence &operator=(const FrameSequence &other);
+
+		std::vector<std::string> _paths;
+		std::vector<char> _text;
+		std::vector<int> _row;
+		int _width;
+		int _height;
+
+		std::vector<int> _ring[RING_SIZE];
+		Region _regions[RING_SIZE];
+		size_t _next;
+		size_t _ready;
+		bool _held;
+		std::mutex _mutex;
+		std::condition_variable _space;
+
+		std::chrono::steady_clock::duration _period;
+		std::chrono::steady_clock::time_point _due;
+		size_t _late;
+
+		std::atomic<bool> _stop;
+		std::thread _reader;
+
+		void readFile(const std::string &path);
+		void parseFrame(int *grid);
+		static Region changedRegion(const std::vector<int> &before, const std::vector<int> &after, int width, int height);
+		void read();
+
+	public:
+		class BadSequenceException : public std::exception{
+			const char *what() const throw();
+		};
+
+		class BadFrameException : public std::exception{
+			const char *what() const throw();
+		};
+
+		FrameSequence(const std::string &pattern, int framesPerSecond = DEFAULT_FPS);
+		~FrameSequence();
+
+		int getWidth() const;
+		int getHeight() const;
+		size_t getLateFrames() const;
+
+		const std::vector<int> *acquireFrame(Region &region);
+};
+
+#endif
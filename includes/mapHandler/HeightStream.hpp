@@ -0,0 +1,110 @@
+/**
+# * @file HeightStream.hpp
+# * @class HeightStream
+# * @brief Receives live height frames from stdin or a named pipe.
+# *
+# * A reader thread parses full or partial frames, in .fdf text or a small binary format,
+# * into its own copy of the grid and publishes it through a triple buffer, so neither the
+# * parser nor the renderer ever waits for the other. Includes custom exceptions for error handling.
+# *
+# * Text frames are rows of heights ended by a blank line, optionally preceded by an
+# * "@ x y" line placing them at column x, row y. Binary frames are a BinaryHeader followed
+# * by width * height int32 heights, row-major, in native byte order. The first frame must
+# * start at (0, 0); its size fixes the grid size. Each published frame carries the
+# * rectangle it changed, so consumers can update only that part of their copy.
+# */
+
+#ifndef HEIGHTSTREAM_HPP
+# define HEIGHTSTREAM_HPP
+
+# include <atomic>
+# include <cstddef>
+# include <cstdint>
+# include <exception>
+# include <mutex>
+# include <string>
+# include <thread>
+# include <vector>
+
+class HeightStream{
+	public:
+		/**
+		 * @brief Header of a binary frame; magic is "FDFH".
+		 */
+		struct BinaryHeader {
+			char magic[4];
+			int32_t x;
+			int32_t y;
+			int32_t width;
+			int32_t height;
+		};
+
+		/**
+		 * @brief Rectangle of grid cells changed by a frame; x1 and y1 are exclusive.
+		 */
+		struct Region {
+			int x0;
+			int y0;
+			int x1;
+			int y1;
+		};
+
+		static const size_t READ_CHUNK = 1 << 16;
+		static const int POLL_TIMEOUT_MS = 100;
+
+	private:
+		HeightStream(const HeightStream &other);
+		HeightStream &operator=(const HeightStream &other);
+
+		int _fd;
+		bool _ownsFd;
+		std::vector<char> _input;
+		size_t _inputBegin;
+		size_t _inputEnd;
+
+		int _width;
+		int _height;
+		std::vector<int> _grid;
+		Region _changed;
+		std::vector<int> _buffers[3];
+		Region _regions[3];
+		int _back;
+		int _ready;
+		int _front;
+		bool _fresh;
+		std::mutex _mutex;
+
+		std::atomic<bool> _stop;
+		std::thread _reader;
+
+		bool fill();
+		int peek();
+		bool readLine(std::string &line);
+		bool readBytes(void *out, size_t size);
+
+		bool readFrame(bool first);
+		bool readTextFrame(bool first);
+		bool readBinaryFrame(bool first);
+		void applyRegion(int x0, int y0, int width, const std::vector<int> &values);
+		void publish();
+		void read();
+
+	public:
+		class BadStreamException : public std::exception{
+			const char *what() const throw();
+		};
+
+		class BadFrameException : public std::exception{
+			const char *what() const throw();
+		};
+
+		HeightStream(const std::string &path);
+		~HeightStream();
+
+		int getWidth() const;
+		int getHeight() const;
+
+		const std::vector<int> *acquireFrame(Region &region);
+};
+
+#endif
@@ -0,0 +1,39 @@
+/**
+# * @file LoadArena.hpp
+# * @class LoadArena
+# * @brief Bump allocator for the text of a map while it is being loaded.
+# *
+# * Map rows, dictionary glyphs and previews are copied into large blocks instead of one
+# * heap string each, and handed out as NUL-terminated string views. Nothing is freed
+# * piecemeal: the whole arena is released in one shot once the rows have been parsed.
+# */
+
+#ifndef LOADARENA_HPP
+# define LOADARENA_HPP
+
+# include <cstddef>
+# include <string_view>
+# include <vector>
+
+class LoadArena{
+	private:
+		LoadArena(const LoadArena &other);
+		LoadArena &operator=(const LoadArena &other);
+
+		std::vector<char *> _blocks;
+		char *_cursor;
+		size_t _left;
+
+	public:
+		static constexpr size_t BLOCK_SIZE = 1 << 20;
+
+		LoadArena();
+		~LoadArena();
+
+		char *allocate(size_t size);
+		std::string_view copy(const char *text, size_t length);
+		void swap(LoadArena &other);
+		void release();
+};
+
+#endif
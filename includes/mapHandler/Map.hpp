@@ -29,6 +29,8 @@ class Map {
 		typedef std::vector<MapPoint> MapLine;
 		
 		Map();
+		Map(Map &&other) = default;
+		Map &operator=(Map &&other) = default;
 		~Map();
 		
 		std::vector<MapLine> &getMapData() { return _mapData; }
@@ -4,20 +4,23 @@
 # * @brief Builds map data from input strings or files, using a dictionary for character mapping.
 # *
 # * Loads map data from a file or string, parses dictionary files for character maps,
-# * and provides methods for building, printing, and validating map input. Includes custom exceptions for error handling.
+# * and provides methods for building, printing, and validating map input. The dictionary and
+# * the map rows live in a LoadArena, whose text is handed over with the rows.
+# * Includes custom exceptions for error handling.
 # */
 
 #ifndef MAPBUILDER_HPP
 # define MAPBUILDER_HPP
 
 # include <iostream>
-# include <map>
 # include <vector>
 # include <fstream>
 # include <stdexcept>
-# include <sstream>
 # include <cstdlib>
+# include <climits>
 # include <string>
+# include <string_view>
+# include "LoadArena.hpp"
 
 class MapBuilder{
 	private:
@@ -25,9 +28,14 @@ class MapBuilder{
 
 		MapBuilder &operator=(const MapBuilder &other);
 
+		static constexpr int GLYPH_ROWS = 24;
+
 		const std::string _dicPath;
-		std::map<int, std::vector<std::string> > _mapDictionary;
-		std::vector<std::string> _map;
+		LoadArena _arena;
+		std::string_view _mapDictionary[UCHAR_MAX + 1][GLYPH_ROWS];
+		std::vector<std::string_view> _map;
+
+		std::string_view glyphRow(char c, int row) const;
 
 	public:
 		class BadDicFileException : public std::exception{
@@ -49,13 +57,14 @@ class MapBuilder{
 		MapBuilder(std::string &input);
 		~MapBuilder();
 
-		std::vector<std::string> &getMap();
+		const std::vector<std::string_view> &getMap() const;
+		std::vector<std::string_view> takeMap(LoadArena &text);
 
 		void feedDictionary();
 		void buildMapFromString(std::string &str);
 		void buildMapFromPath(std::string &str);
 
-		bool checkInputType(std::string &input);
+		static bool checkInputType(std::string &input);
 
 		void mapPrinter();
 		void dictionaryPrinter();
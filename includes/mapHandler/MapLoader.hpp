@@ -0,0 +1,67 @@
+/**
+# * @file MapLoader.hpp
+# * @class MapLoader
+# * @brief Reads a map file on a background thread and serves subsampled previews.
+# *
+# * Lets the window open and show a coarse version of a large map while the rest of the
+# * file is still being read. Rows are appended in batches as they arrive; previews keep
+# * every k-th row and column of what has been read so far. Rows are kept as views into
+# * a LoadArena, whose text is handed to the caller with them.
+# */
+
+#ifndef MAPLOADER_HPP
+# define MAPLOADER_HPP
+
+# include <atomic>
+# include <chrono>
+# include <condition_variable>
+# include <cstddef>
+# include <fstream>
+# include <mutex>
+# include <string>
+# include <string_view>
+# include <thread>
+# include <vector>
+# include "LoadArena.hpp"
+
+class MapLoader{
+	private:
+		MapLoader(const MapLoader &other);
+		MapLoader &operator=(const MapLoader &other);
+
+		std::ifstream _file;
+		size_t _fileSize;
+		std::atomic<size_t> _bytesRead;
+		std::atomic<bool> _done;
+		std::atomic<bool> _stop;
+
+		mutable std::mutex _mutex;
+		mutable std::condition_variable _progress;
+		LoadArena _arena;
+		std::vector<std::string_view> _rows;
+		size_t _columns;
+
+		std::thread _reader;
+
+		void read();
+		double estimatePoints() const;
+
+	public:
+		static constexpr size_t PREVIEW_POINTS = 1 << 18;
+		static constexpr size_t BATCH_ROWS = 256;
+		static constexpr size_t DIRECT_POINTS = 1 << 20;
+		static constexpr int PREVIEW_DELAY_MS = 250;
+
+		MapLoader(const std::string &path);
+		~MapLoader();
+
+		bool isDone() const;
+		size_t getRowCount() const;
+		size_t getExpectedPoints() const;
+		bool waitUntilDone(std::chrono::milliseconds timeout) const;
+
+		std::vector<std::string_view> getPreview(LoadArena &arena, size_t maxPoints = PREVIEW_POINTS) const;
+		std::vector<std::string_view> takeRows(LoadArena &text);
+};
+
+#endif
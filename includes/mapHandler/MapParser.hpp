@@ -4,6 +4,7 @@
 # * @brief Validates and parses map matrices for correct format and structure.
 # *
 # * Checks the format of a map matrix, ensuring consistent row lengths and valid structure.
+# * Also parses single rows of heights for the readers that drop per-point colors.
 # * Provides error handling for malformed maps.
 # */
 
@@ -26,6 +27,8 @@ class MapParser{
 		~MapParser();
 
 		bool parseMap();
+
+		static const char *parseHeights(const char *cursor, std::vector<int> &row);
 };
 
 #endif
\ No newline at end of file
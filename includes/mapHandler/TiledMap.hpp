@@ -0,0 +1,122 @@
+/**
+# * @file TiledMap.hpp
+# * @class TiledMap
+# * @brief Memory-mapped, tiled height map for maps larger than RAM.
+# *
+# * A .fdft file stores the height grid as a pyramid of detail levels, each cut into
+# * square tiles. The file is mapped read-only and tiles are paged in on demand through
+# * an LRU cache bounded by a memory budget. Includes the streaming converter from .fdf
+# * text maps and custom exceptions for error handling.
+# */
+
+#ifndef TILEDMAP_HPP
+# define TILEDMAP_HPP
+
+# include <cstdint>
+# include <cstddef>
+# include <exception>
+# include <list>
+# include <optional>
+# include <string>
+# include <unordered_map>
+# include <vector>
+
+class TiledMap {
+	public:
+		/**
+		 * @brief Fixed-size file header, stored in native byte order.
+		 */
+		struct Header {
+			char magic[4];
+			uint32_t version;
+			uint32_t width;
+			uint32_t height;
+			uint32_t tileSize;
+			uint32_t levelCount;
+			uint32_t hasNoData;
+			int32_t noDataValue;
+			int32_t minHeight;
+			int32_t maxHeight;
+		};
+
+		/**
+		 * @brief One detail level. Level 0 is the full grid; level l keeps every
+		 *        2^l-th vertex along both axes.
+		 *
+		 * Its tiles are stored row-major starting at firstTile in the tile table.
+		 */
+		struct Level {
+			uint32_t width;
+			uint32_t height;
+			uint32_t tilesX;
+			uint32_t tilesY;
+			uint64_t firstTile;
+		};
+
+		/**
+		 * @brief Tile table entry: payload offset and height range.
+		 *
+		 * Tile (tx, ty) holds (tileSize + 1)^2 samples row-major, for vertices
+		 * [tx * tileSize, tx * tileSize + tileSize] on both axes, so neighboring tiles
+		 * share their border. Samples past the level's edge repeat the last vertex.
+		 * The range ignores no-data samples.
+		 */
+		struct Tile {
+			uint64_t offset;
+			int32_t minZ;
+			int32_t maxZ;
+		};
+
+		static const uint32_t VERSION = 1;
+		static const uint32_t MAX_TILE_SIZE = 4096;
+		static const size_t TILE_ALIGNMENT = 4096;
+		static const size_t OVERVIEW_POINTS = 1 << 20;
+		static const size_t DEFAULT_MEMORY_BUDGET = 256u << 20;
+
+	private:
+		TiledMap(const TiledMap &other);
+		TiledMap &operator=(const TiledMap &other);
+
+		int _fd;
+		const uint8_t *_data;
+		size_t _size;
+		const Header *_header;
+		const Level *_levels;
+		const Tile *_tiles;
+		size_t _tileBytes;
+		size_t _memoryBudget;
+		std::list<uint64_t> _recent;
+		std::unordered_map<uint64_t, std::list<uint64_t>::iterator> _resident;
+
+		void advise(uint64_t tile, int advice) const;
+
+	public:
+		class BadTiledFileException : public std::exception{
+			const char *what() const throw();
+		};
+
+		class BadTiledFormatException : public std::exception{
+			const char *what() const throw();
+		};
+
+		TiledMap(const std::string &path, size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+		~TiledMap();
+
+		static bool isTiledPath(const std::string &path);
+		static void convert(const std::string &input, const std::string &output,
+							std::optional<int> noDataValue, int tileSize = 64);
+
+		int getWidth() const;
+		int getHeight() const;
+		int getTileSize() const;
+		int getLevelCount() const;
+		std::optional<int> getNoDataValue() const;
+		const Level &getLevel(int level) const;
+		const Tile &getTile(int level, int tx, int ty) const;
+
+		int getOverviewLevel(size_t maxPoints = OVERVIEW_POINTS) const;
+		std::vector<int> readLevel(int level) const;
+		const int32_t *acquireTile(int level, int tx, int ty);
+};
+
+#endif
@@ -1,12 +1,43 @@
 #ifndef CABINETPROJECTION_HPP
 # define CABINETPROJECTION_HPP
 
-#include "IProjection.hpp"
+# include <utility>
+# include <cmath>
 
-class CabinetProjection : public IProjection{
+class CabinetProjection{
 	public:
 		~CabinetProjection();
-		virtual std::pair<int, int> project(int &x, int &y, int &z) const;
+
+		static constexpr bool IS_AFFINE = true;
+		static constexpr bool HAS_DEPTH = false;
+		static constexpr bool IS_CURVED = false;
+
+		/**
+		 * @brief Distance along the oblique receding axis, smaller is closer.
+		 */
+		double depth(double x, double y, double z) const {
+			double factor = 0.5;
+			return -(-x * factor * cos(M_PI / 4) + y * factor * sin(M_PI / 4) + z);
+		}
+
+		/**
+		 * @brief Projects 3D coordinates to 2D using cabinet projection.
+		 * 
+		 * Applies cabinet projection with a 45-degree angle and 0.5 scaling factor
+		 * for the depth dimension. This creates a less distorted oblique view compared
+		 * to cavalier projection.
+		 * 
+		 * @param x X coordinate in 3D space.
+		 * @param y Y coordinate in 3D space.
+		 * @param z Z coordinate (depth) in 3D space.
+		 * @return A pair containing the cabinet-projected 2D screen coordinates.
+		 */
+		std::pair<int, int> project(int x, int y, int z) const {
+			double factor = 0.5;
+			int newX = x + z * factor * cos(M_PI / 4);
+			int newY = y - z * factor * sin(M_PI / 4);
+			return {newX, newY};
+		}
 };
 
 #endif
\ No newline at end of file
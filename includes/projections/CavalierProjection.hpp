@@ -1,12 +1,43 @@
 #ifndef CAVALIERPROJECTION_HPP
 # define CAVALIERPROJECTION_HPP
 
-#include "IProjection.hpp"
+# include <utility>
+# include <cmath>
 
-class CavalierProjection : public IProjection{
+class CavalierProjection{
 	public:
 		~CavalierProjection();
-		virtual std::pair<int, int> project(int &x, int &y, int &z) const;
+
+		static constexpr bool IS_AFFINE = true;
+		static constexpr bool HAS_DEPTH = false;
+		static constexpr bool IS_CURVED = false;
+
+		/**
+		 * @brief Distance along the oblique receding axis, smaller is closer.
+		 */
+		double depth(double x, double y, double z) const {
+			double angle = M_PI / 4;
+			return -(-x * cos(angle) + y * sin(angle) + z);
+		}
+
+		/**
+		 * @brief Projects 3D coordinates to 2D using cavalier projection.
+		 * 
+		 * Applies cavalier projection with a 45-degree angle and full scaling (factor = 1.0)
+		 * for the depth dimension. This preserves the true length of receding edges but
+		 * may appear more distorted than cabinet projection.
+		 * 
+		 * @param x X coordinate in 3D space.
+		 * @param y Y coordinate in 3D space.
+		 * @param z Z coordinate (depth) in 3D space.
+		 * @return A pair containing the cavalier-projected 2D screen coordinates.
+		 */
+		std::pair<int, int> project(int x, int y, int z) const {
+			double angle = M_PI / 4;
+			int newX = x + z * cos(angle);
+			int newY = y - z * sin(angle);
+			return {newX, newY};
+		}
 };
 
 #endif
\ No newline at end of file
@@ -1,9 +1,10 @@
 #ifndef CONICPROJECTION_HPP
 # define CONICPROJECTION_HPP
 
-#include "IProjection.hpp"
+# include <utility>
+# include <cmath>
 
-class ConicProjection : public IProjection {
+class ConicProjection {
 private:
     double _distance;   // Distance from viewer to projection plane
     double _fugueX;     // X coordinate of vanishing point (fugue point)
@@ -14,7 +15,58 @@ public:
     ConicProjection(); // Default constructor with reasonable defaults
     ~ConicProjection();
     
-    std::pair<int, int> project(int &x, int &y, int &z) const override;
+    static constexpr bool IS_AFFINE = false;
+    static constexpr bool HAS_DEPTH = true;
+    static constexpr bool IS_CURVED = true;
+
+    /**
+     * @brief Depth of a point along the rotated viewing axis.
+     *
+     * Same quantity project() clamps to 0.1 before dividing; points below
+     * nearDepth() are clipped by the renderer instead of relying on that clamp.
+     */
+    double depth(double x, double y, double z) const {
+        (void)z;
+        return x * sin(M_PI / 6) + y * cos(M_PI / 6) + _distance;
+    }
+
+    /**
+     * @brief Smallest depth accepted before projection; keeps scale under 20.
+     */
+    double nearDepth() const {
+        return _distance * 0.05;
+    }
+
+    /**
+     * @brief Projects 3D coordinates to 2D using conic projection.
+     * 
+     * Applies a complex transformation involving rotation, perspective scaling,
+     * and vanishing point calculations. First rotates the coordinates by 30 degrees
+     * (π/6), then applies perspective division based on depth, and finally projects
+     * toward the configured vanishing point.
+     * 
+     * @param x X coordinate in 3D space.
+     * @param y Y coordinate in 3D space.
+     * @param z Z coordinate (height) in 3D space.
+     * @return A pair containing the conic-projected 2D screen coordinates.
+     */
+    std::pair<int, int> project(int x, int y, int z) const {
+        double viewAngle = M_PI / 6;
+
+        double rotatedX = x * cos(viewAngle) - y * sin(viewAngle);
+        double rotatedY = x * sin(viewAngle) + y * cos(viewAngle);
+        double rotatedZ = z;
+
+        double depth = rotatedY + _distance;
+        if (depth <= 0.1) depth = 0.1;
+
+        double scale = _distance / depth;
+
+        double projectedX = _fugueX + (rotatedX - _fugueX) * scale;
+        double projectedY = _fugueY + (rotatedZ * scale + rotatedY * 0.3);
+
+        return {static_cast<int>(projectedX), static_cast<int>(projectedY)};
+    }
 };
 
 #endif
\ No newline at end of file
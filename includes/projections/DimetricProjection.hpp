@@ -1,12 +1,45 @@
 #ifndef DIMETRICPROJECTION_HPP
 # define DIMETRICPROJECTION_HPP
 
-#include "IProjection.hpp"
+# include <utility>
+# include <cmath>
 
-class DimetricProjection : public IProjection{
+class DimetricProjection{
 	public:
 		~DimetricProjection();
-		virtual std::pair<int, int> project(int &x, int &y, int &z) const;
+
+		static constexpr bool IS_AFFINE = true;
+		static constexpr bool HAS_DEPTH = false;
+		static constexpr bool IS_CURVED = false;
+
+		/**
+		 * @brief Distance along the viewing direction, smaller is closer.
+		 */
+		double depth(double x, double y, double z) const {
+			double alpha = M_PI / 8;
+			double beta = M_PI / 4;
+			return -(-x * cos(beta) + y * cos(alpha) + z * sin(beta - alpha));
+		}
+
+		/**
+		 * @brief Projects 3D coordinates to 2D using dimetric projection.
+		 * 
+		 * Applies dimetric transformation using specific angles (π/8 and π/4) to create
+		 * the characteristic dimetric view where two axes have equal foreshortening.
+		 * The Z-coordinate directly affects the Y-position without angular transformation.
+		 * 
+		 * @param x X coordinate in 3D space.
+		 * @param y Y coordinate in 3D space.
+		 * @param z Z coordinate (height) in 3D space.
+		 * @return A pair containing the dimetric-projected 2D screen coordinates.
+		 */
+		std::pair<int, int> project(int x, int y, int z) const {
+			double alpha = M_PI / 8;
+			double beta = M_PI / 4;
+			int newX = x * cos(alpha) + y * cos(beta);
+			int newY = x * sin(alpha) + y * sin(beta) - z;
+			return {newX, newY};
+		}
 };
 
 #endif
\ No newline at end of file
@@ -1,14 +1,46 @@
 #ifndef HYPERBOLICPROJECTION_HPP
 # define HYPERBOLICPROJECTION_HPP
 
-# include "IProjection.hpp"
+# include <utility>
+# include <cmath>
+# include <cstdlib>
 
-class HyperbolicProjection : public IProjection{
+class HyperbolicProjection{
 		public:
 			HyperbolicProjection();
 			~HyperbolicProjection();
 
-			std::pair<int, int> project(int &x, int &y, int &z) const;
+			static constexpr bool IS_AFFINE = false;
+			static constexpr bool HAS_DEPTH = false;
+			static constexpr bool IS_CURVED = true;
+
+			/**
+			 * @brief Top-down distance to the viewer used for depth ordering, smaller is closer.
+			 */
+			double depth(double x, double y, double z) const {
+				(void)x;
+				(void)y;
+				return -z;
+			}
+
+			/**
+			 * @brief Projects 3D coordinates to 2D using hyperbolic projection.
+			 * 
+			 * Applies a hyperbolic scaling factor based on the absolute Z-coordinate value.
+			 * Points with higher Z-values (further from the origin) are scaled down more
+			 * dramatically, creating a curved space effect similar to hyperbolic geometry.
+			 * 
+			 * @param x X coordinate in 3D space.
+			 * @param y Y coordinate in 3D space.
+			 * @param z Z coordinate (height) in 3D space.
+			 * @return A pair containing the hyperbolically-projected 2D screen coordinates.
+			 */
+			std::pair<int, int> project(int x, int y, int z) const {
+				double scale = 1.0 / (1.0 + abs(z) * 0.05);
+				int newX = x * scale;
+				int newY = y * scale;
+				return {newX, newY};
+			}
 };
 
 #endif
\ No newline at end of file
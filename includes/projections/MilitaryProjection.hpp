@@ -1,12 +1,42 @@
 #ifndef MILITARYPROJECTION_HPP
 # define MILITARYPROJECTION_HPP
 
-#include "IProjection.hpp"
+# include <utility>
+# include <cmath>
 
-class MilitaryProjection : public IProjection{
+class MilitaryProjection{
 	public:
 		~MilitaryProjection();
-		virtual std::pair<int, int> project(int &x, int &y, int &z) const;
+
+		static constexpr bool IS_AFFINE = true;
+		static constexpr bool HAS_DEPTH = false;
+		static constexpr bool IS_CURVED = false;
+
+		/**
+		 * @brief Distance along the viewing direction (0, 1, 1), smaller is closer.
+		 */
+		double depth(double x, double y, double z) const {
+			(void)x;
+			return -(y + z);
+		}
+
+		/**
+		 * @brief Projects 3D coordinates to 2D using military projection.
+		 * 
+		 * Applies a simple transformation where the X-coordinate remains unchanged
+		 * and the Y-coordinate is adjusted by subtracting the Z (height) value,
+		 * creating a side-view profile.
+		 * 
+		 * @param x X coordinate in 3D space (unchanged).
+		 * @param y Y coordinate in 3D space.
+		 * @param z Z coordinate (height) in 3D space.
+		 * @return A pair containing the military-projected 2D screen coordinates.
+		 */
+		std::pair<int, int> project(int x, int y, int z) const {
+			int newX = x;
+			int newY = y - z;
+			return {newX, newY};
+		}
 };
 
 #endif
\ No newline at end of file
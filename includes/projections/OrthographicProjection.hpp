@@ -1,12 +1,41 @@
 #ifndef ORTOGRAPHICPROJECTION_HPP
 # define ORTOGRAPHICPROJECTION_HPP
 
-# include "IProjection.hpp"
+# include <utility>
+# include <cmath>
 
-class OrthographicProjection : public IProjection{
+class OrthographicProjection{
 	public:
 		~OrthographicProjection();
-		virtual std::pair<int, int> project(int &x, int &y, int &z) const;
+
+		static constexpr bool IS_AFFINE = true;
+		static constexpr bool HAS_DEPTH = false;
+		static constexpr bool IS_CURVED = false;
+
+		/**
+		 * @brief Top-down distance to the viewer, smaller is closer.
+		 */
+		double depth(double x, double y, double z) const {
+			(void)x;
+			(void)y;
+			return -z;
+		}
+
+		/**
+		 * @brief Projects 3D coordinates to 2D using orthographic projection.
+		 * 
+		 * Simply ignores the Z-coordinate and returns the X and Y coordinates unchanged,
+		 * creating a flat, top-down view without any perspective effects.
+		 * 
+		 * @param x X coordinate in 3D space.
+		 * @param y Y coordinate in 3D space.
+		 * @param z Z coordinate (height) in 3D space (unused).
+		 * @return A pair containing the X and Y coordinates as 2D screen coordinates.
+		 */
+		std::pair<int, int> project(int x, int y, int z) const {
+			(void)z;
+			return {x, y};
+		}
 };
 
 #endif
\ No newline at end of file
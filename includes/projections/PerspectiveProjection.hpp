@@ -1,9 +1,10 @@
 #ifndef PERSPECTIVEPROJECTION_HPP
 # define PERSPECTIVEPROJECTION_HPP
 
-# include "IProjection.hpp"
+# include <utility>
+# include <cmath>
 
-class PerspectiveProjection : public IProjection{
+class PerspectiveProjection{
 		private:
 			double _distance;
 		
@@ -11,7 +12,48 @@ class PerspectiveProjection : public IProjection{
 			PerspectiveProjection(double distance = 1000.0);
 			~PerspectiveProjection();
 
-			std::pair<int, int> project(int &x, int &y, int &z) const;
+			static constexpr bool IS_AFFINE = false;
+			static constexpr bool HAS_DEPTH = true;
+			static constexpr bool IS_CURVED = false;
+
+			/**
+			 * @brief Distance from the viewer along the viewing axis.
+			 *
+			 * project() divides by this value, so points whose depth falls below
+			 * nearDepth() must be clipped away before being projected.
+			 */
+			double depth(double x, double y, double z) const {
+				(void)x;
+				(void)y;
+				return _distance - z;
+			}
+
+			/**
+			 * @brief Smallest depth accepted before projection; caps magnification at 20x.
+			 */
+			double nearDepth() const {
+				return _distance * 0.05;
+			}
+
+			/**
+			 * @brief Projects 3D coordinates to 2D using perspective projection.
+			 * 
+			 * Applies perspective scaling based on the viewing distance and the object's depth.
+			 * Objects further from the viewer (negative Z) appear smaller, creating realistic
+			 * depth perception.
+			 * 
+			 * @param x X coordinate in 3D space.
+			 * @param y Y coordinate in 3D space.
+			 * @param z Z coordinate (depth) in 3D space.
+			 * @return A pair containing the perspective-corrected 2D screen coordinates.
+			 */
+			std::pair<int, int> project(int x, int y, int z) const {
+				double adjustedZ = -z;
+				double scale = _distance / (_distance + adjustedZ);
+				int newX = x * scale;
+				int newY = y * scale;
+				return {newX, newY};
+			}
 };
 
 #endif
\ No newline at end of file
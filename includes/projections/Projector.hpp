@@ -2,7 +2,7 @@
 # define PROJECTOR_HPP
 
 # include <stdexcept>
-# include "../../includes/projections/IProjection.hpp"
+# include <variant>
 # include "../../includes/projections/IsometricProjection.hpp"
 # include "../../includes/projections/OrthographicProjection.hpp"
 # include "../../includes/projections/PerspectiveProjection.hpp"
@@ -16,24 +16,42 @@
 # include "../../includes/projections/ConicProjection.hpp"
 # include "../../includes/projections/SphericalConicProjection.hpp"
 
+/**
+ * @brief Closed set of supported projections.
+ *
+ * Every alternative provides an inline, non-virtual
+ * `std::pair<int, int> project(int x, int y, int z) const` and a
+ * `static constexpr bool IS_AFFINE` telling whether project() is a linear map.
+ * `double depth(x, y, z) const` gives the distance to the viewer (smaller is
+ * closer) for depth testing. Alternatives with `HAS_DEPTH` set divide by that
+ * depth and also provide `double nearDepth() const` for near-plane clipping. `IS_CURVED` marks projections that bend straight edges, which the
+ * renderer subdivides.
+ * Hot loops std::visit this variant once and run a loop instantiated for the
+ * concrete type, so the projection math is inlined with no per-point dispatch.
+ */
+typedef std::variant<
+	IsometricProjection,
+	PerspectiveProjection,
+	OrthographicProjection,
+	TrimetricProjection,
+	DimetricProjection,
+	CabinetProjection,
+	CavalierProjection,
+	MilitaryProjection,
+	RecursiveDepth,
+	HyperbolicProjection,
+	ConicProjection,
+	SphericalConicProjection
+> Projection;
+
 class Projector{
 	private:
-		IProjection *_selectedProjection;
-		
-		IsometricProjection *_isometric;
-		PerspectiveProjection *_perspective;
-		OrthographicProjection *_orthographic;
-		TrimetricProjection *_trimetric;
-		CabinetProjection *_cabinet;
-		DimetricProjection *_dimetric;
-		CavalierProjection *_cavalier;
-		MilitaryProjection *_military;
-		RecursiveDepth *_recursive;
-		HyperbolicProjection *_hyperbolic;
-		ConicProjection *_conic;
-		SphericalConicProjection *_spherical;
+		Projection _selectedProjection;
+		int _type;
 
 	public:
+		static const int PROJECTION_COUNT = 12;
+
 		class BadProjectionException : public std::exception{
 			const char *what() const throw();	
 		};
@@ -41,9 +59,12 @@ class Projector{
 		Projector();
 		~Projector();
 
-		IProjection *getProjection();
+		const Projection &getProjection() const;
+		int getType() const;
+		bool isAffine() const;
+		std::pair<int, int> project(int x, int y, int z) const;
 
 		void setType(int type);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,13 +2,48 @@
 # define RECURSIVEDEPTHPROJECTION_HPP
 
 # include <algorithm>
+# include <utility>
+# include <cmath>
+# include <cstdlib>
 
-# include "IProjection.hpp"
-
-class RecursiveDepth : public IProjection{
+class RecursiveDepth{
 	public:
 		~RecursiveDepth();
-		virtual std::pair<int, int> project(int &x, int &y, int &z) const;
+
+		static constexpr bool IS_AFFINE = false;
+		static constexpr bool HAS_DEPTH = false;
+		static constexpr bool IS_CURVED = true;
+
+		/**
+		 * @brief Depth used to order overlapping pixels; the map is seen from above.
+		 */
+		double depth(double x, double y, double z) const {
+			(void)x;
+			(void)y;
+			return -z;
+		}
+
+		/**
+		 * @brief Projects 3D coordinates to 2D using recursive depth projection.
+		 * 
+		 * Wraps the Z-coordinate within a loop depth of 100 units and applies scaling
+		 * based on the wrapped value. This creates a recursive visual effect where
+		 * depth patterns repeat, useful for visualizing infinite or cyclic structures.
+		 * 
+		 * @param x X coordinate in 3D space.
+		 * @param y Y coordinate in 3D space.
+		 * @param z Z coordinate (height) in 3D space.
+		 * @return A pair containing the recursively-projected 2D screen coordinates.
+		 */
+		std::pair<int, int> project(int x, int y, int z) const {
+			int loopDepth = 100;
+			int wrappedZ = z % loopDepth;
+
+			double scale = 1.0 / (1.0 + abs(wrappedZ) * 0.01);
+			int newX = x * scale;
+			int newY = y * scale;
+			return {newX, newY};
+		}
 };
 
 #endif
\ No newline at end of file
@@ -13,9 +13,10 @@
 #ifndef SPHERICALCONICPROJECTION_HPP
 # define SPHERICALCONICPROJECTION_HPP
 
-#include "./IProjection.hpp"
+# include <utility>
+# include <cmath>
 
-class SphericalConicProjection : public IProjection {
+class SphericalConicProjection {
 private:
     double _radius;
 
@@ -24,7 +25,58 @@ public:
     SphericalConicProjection();
     ~SphericalConicProjection();
     
-    std::pair<int, int> project(int &x, int &y, int &z) const override;
+    static constexpr bool IS_AFFINE = false;
+    static constexpr bool HAS_DEPTH = true;
+    static constexpr bool IS_CURVED = true;
+
+    /**
+     * @brief Depth of a point once mapped onto the projection sphere.
+     *
+     * Not linear in the input coordinates: it approaches zero for points
+     * pointing toward -Y, where the conic scale blows up.
+     */
+    double depth(double x, double y, double z) const {
+        double distance = sqrt(x*x + y*y + z*z);
+        if (distance == 0) distance = 1;
+        return _radius + y * _radius / distance;
+    }
+
+    /**
+     * @brief Minimum depth drawn, as a fraction of the sphere radius.
+     */
+    double nearDepth() const {
+        return _radius * 0.05;
+    }
+
+    /**
+     * @brief Projects 3D coordinates to 2D using spherical conic projection.
+     * 
+     * First normalizes the 3D coordinates to lie on a sphere of the specified radius,
+     * then applies a conic perspective transformation. The spherical mapping ensures
+     * all points lie on the sphere surface before the final 2D projection.
+     * 
+     * @param x X coordinate in 3D space.
+     * @param y Y coordinate in 3D space.
+     * @param z Z coordinate (height) in 3D space.
+     * @return A pair containing the spherical-conic-projected 2D screen coordinates.
+     */
+    std::pair<int, int> project(int x, int y, int z) const {
+        double distance = sqrt(x*x + y*y + z*z);
+        if (distance == 0) distance = 1;
+
+        double sphereX = x * _radius / distance;
+        double sphereY = y * _radius / distance;
+        double sphereZ = z * _radius / distance;
+
+        double depth = _radius + sphereY;
+        if (depth <= 0.1) depth = 0.1;
+        double scale = _radius / depth;
+
+        int newX = sphereX * scale;
+        int newY = sphereZ * scale;
+
+        return {newX, newY};
+    }
 };
 
 #endif
\ No newline at end of file
@@ -13,12 +13,49 @@
 #ifndef TRIMETRICPROJECTION_HPP
 # define TRIMETRICPROJECTION_HPP
 
-#include "IProjection.hpp"
+# include <utility>
+# include <cmath>
 
-class TrimetricProjection : public IProjection{
+class TrimetricProjection{
 	public:
 		~TrimetricProjection();
-		virtual std::pair<int, int> project(int &x, int &y, int &z) const;
+
+		static constexpr bool IS_AFFINE = true;
+		static constexpr bool HAS_DEPTH = false;
+		static constexpr bool IS_CURVED = false;
+
+		/**
+		 * @brief Distance along the viewing direction, the null space of project().
+		 */
+		double depth(double x, double y, double z) const {
+			double angleX = M_PI / 6;
+			double angleY = M_PI / 3;
+			double angleZ = M_PI / 4;
+
+			return -(x * cos(angleY) * sin(angleZ) + y * cos(angleX) * sin(angleZ) + z * sin(angleX + angleY));
+		}
+
+		/**
+		 * @brief Projects 3D coordinates to 2D using trimetric projection.
+		 * 
+		 * Applies trimetric transformation using three different angles (π/6, π/3, π/4)
+		 * for the X, Y, and Z axes respectively. This creates a unique 3D view where
+		 * each axis has its own distinct foreshortening ratio.
+		 * 
+		 * @param x X coordinate in 3D space.
+		 * @param y Y coordinate in 3D space.
+		 * @param z Z coordinate (height) in 3D space.
+		 * @return A pair containing the trimetric-projected 2D screen coordinates.
+		 */
+		std::pair<int, int> project(int x, int y, int z) const {
+			double angleX = M_PI / 6;
+			double angleY = M_PI / 3;
+			double angleZ = M_PI / 4;
+
+			int newX = x * cos(angleX) - y * cos(angleY);
+			int newY = x * sin(angleX) + y * sin(angleY) - z * sin(angleZ);
+			return {newX, newY};
+		}
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+/**
+ * @file AllocationCounter.cpp
+ * @brief Implements the AllocationCounter class and, in benchmark builds, the counting allocators.
+ */
+
+#include "../includes/AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef FDF_COUNT_ALLOCATIONS
+
+static std::atomic<size_t> allocations(0);
+
+extern "C" {
+	void *__real_malloc(size_t size);
+	void *__real_calloc(size_t count, size_t size);
+	void *__real_realloc(void *memory, size_t size);
+
+	void *__wrap_malloc(size_t size) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		return __real_malloc(size);
+	}
+
+	void *__wrap_calloc(size_t count, size_t size) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		return __real_calloc(count, size);
+	}
+
+	void *__wrap_realloc(void *memory, size_t size) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		return __real_realloc(memory, size);
+	}
+}
+
+/**
+ * @brief Allocates through malloc, whose wrapper does the counting.
+ */
+void *operator new(size_t size) {
+	void *memory = std::malloc(size ? size : 1);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void *memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept {
+	std::free(memory);
+}
+
+bool AllocationCounter::isEnabled() {
+	return true;
+}
+
+size_t AllocationCounter::getCount() {
+	return allocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+bool AllocationCounter::isEnabled() {
+	return false;
+}
+
+size_t AllocationCounter::getCount() {
+	return 0;
+}
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Implements the Benchmark class, which times frames and counts their allocations.
+ */
+
+#include "../includes/Benchmark.hpp"
+#include "../includes/AllocationCounter.hpp"
+#include <algorithm>
+#include <iostream>
+
+/**
+ * @brief Constructs a benchmark measuring a number of frames after the warm-up.
+ *
+ * @param frames Number of frames to measure; at least 1.
+ */
+Benchmark::Benchmark(int frames)
+	: _frames(std::max(1, frames)), _frame(0), _startAllocations(0), _totalMs(0.0), _worstMs(0.0),
+	  _allocations(0), _allocatingFrames(0) {}
+
+/**
+ * @brief Destructor for Benchmark.
+ */
+Benchmark::~Benchmark() {}
+
+/**
+ * @brief Marks the start of a frame; call before the frame's first hook.
+ */
+void Benchmark::beginFrame() {
+	_startAllocations = AllocationCounter::getCount();
+	_start = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Marks the end of a frame; call after the frame's last hook.
+ *
+ * Warm-up frames are not recorded.
+ */
+void Benchmark::endFrame() {
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count();
+	size_t allocations = AllocationCounter::getCount() - _startAllocations;
+
+	if (_frame++ < WARMUP_FRAMES)
+		return;
+	_totalMs += ms;
+	_worstMs = std::max(_worstMs, ms);
+	_allocations += allocations;
+	if (allocations > 0)
+		_allocatingFrames++;
+}
+
+bool Benchmark::isDone() const {
+	return _frame >= WARMUP_FRAMES + _frames;
+}
+
+/**
+ * @brief Whether no measured frame allocated; always true without allocation counting.
+ */
+bool Benchmark::hasPassed() const {
+	return _allocatingFrames == 0;
+}
+
+/**
+ * @brief Prints the frame times and allocation counts of the measured frames.
+ */
+void Benchmark::report() const {
+	int measured = std::max(0, _frame - WARMUP_FRAMES);
+
+	std::cout << "Bench: " << measured << " frames, avg " << (measured > 0 ? _totalMs / measured : 0.0)
+		<< " ms, worst " << _worstMs << " ms, ";
+	if (AllocationCounter::isEnabled())
+		std::cout << _allocations << " allocations in " << _allocatingFrames << " frames" << std::endl;
+	else
+		std::cout << "allocations not counted (build with make bench)" << std::endl;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file Brush.cpp
+ * @brief Implements the Brush class, which computes terrain sculpting strokes.
+ */
+
+#include "../includes/Brush.hpp"
+#include <cmath>
+
+/**
+ * @brief Constructs a Brush, initially off, with the default radius.
+ */
+Brush::Brush() : _mode(OFF), _radius(DEFAULT_RADIUS) {}
+
+/**
+ * @brief Destructor for Brush.
+ */
+Brush::~Brush() {}
+
+/**
+ * @brief Switches to the next mode: off, raise, lower, smooth, then off again.
+ */
+void Brush::cycleMode() {
+    _mode = static_cast<Mode>((_mode + 1) % MODE_COUNT);
+}
+
+Brush::Mode Brush::getMode() const {
+    return _mode;
+}
+
+/**
+ * @brief Short upper-case name of the current mode, for the UI.
+ */
+const char *Brush::getModeName() const {
+    static const char *names[MODE_COUNT] = {"OFF", "RAISE", "LOWER", "SMOOTH"};
+    return names[_mode];
+}
+
+/**
+ * @brief Sets the brush radius, clamped to [MIN_RADIUS, MAX_RADIUS].
+ *
+ * @param radius Radius in grid vertices.
+ */
+void Brush::setRadius(int radius) {
+    _radius = std::max(MIN_RADIUS, std::min(radius, MAX_RADIUS));
+}
+
+int Brush::getRadius() const {
+    return _radius;
+}
+
+/**
+ * @brief Computes the heights of one stroke centered on a grid vertex.
+ *
+ * Raising and lowering move each vertex by a step proportional to the map's
+ * height range; smoothing pulls it toward the mean of its 3x3 neighborhood.
+ * Both are weighted by a smooth falloff that reaches zero at the rim. No-data
+ * vertices are left untouched.
+ *
+ * @param heightMap Height map being sculpted.
+ * @param x Column of the stroke center.
+ * @param y Row of the stroke center.
+ * @param result Set to the rectangle of new heights.
+ * @return False if the brush is off or the center is outside the grid.
+ */
+bool Brush::stroke(const HeightMap &heightMap, int x, int y, Stroke &result) {
+    int width = heightMap.getMatrixWidth();
+    int height = heightMap.getMatrixHeight();
+    if (_mode == OFF || x < 0 || y < 0 || x >= width || y >= height)
+        return false;
+
+    result.x0 = std::max(0, x - _radius);
+    result.y0 = std::max(0, y - _radius);
+    result.width = std::min(width, x + _radius + 1) - result.x0;
+    result.height = std::min(height, y + _radius + 1) - result.y0;
+    result.minZ = INT_MAX;
+    result.maxZ = INT_MIN;
+    _patch.resize(static_cast<size_t>(result.width) * result.height);
+
+    double reach = _radius + 0.5;
+    double step = std::max(1.0, (static_cast<double>(heightMap.getMaxHeight()) - heightMap.getMinHeight()) * STRENGTH);
+    int *out = _patch.data();
+    for (int py = result.y0; py < result.y0 + result.height; py++) {
+        for (int px = result.x0; px < result.x0 + result.width; px++, out++) {
+            int z = heightMap.getZ(px, py);
+            *out = z;
+            if (heightMap.isNoData(px, py))
+                continue;
+
+            double distance = std::hypot(px - x, py - y) / reach;
+            if (distance < 1.0)
+                *out = sculptedHeight(heightMap, px, py, (1.0 - distance * distance) * (1.0 - distance * distance), step);
+            result.minZ = std::min(result.minZ, std::min(z, *out));
+            result.maxZ = std::max(result.maxZ, std::max(z, *out));
+        }
+    }
+    if (result.minZ > result.maxZ) {
+        result.minZ = 0;
+        result.maxZ = 0;
+    }
+    result.heights = _patch.data();
+    return true;
+}
+
+/**
+ * @brief New height of one vertex under the brush.
+ *
+ * @param heightMap Height map being sculpted.
+ * @param x Column of the vertex.
+ * @param y Row of the vertex.
+ * @param weight Falloff at the vertex, in (0, 1].
+ * @param step Full-strength height change for raising and lowering.
+ * @return The new raw height, never equal to the no-data value.
+ */
+int Brush::sculptedHeight(const HeightMap &heightMap, int x, int y, double weight, double step) const {
+    int z = heightMap.getZ(x, y);
+    double change;
+
+    if (_mode == SMOOTH) {
+        long sum = 0;
+        int count = 0;
+        for (int ny = std::max(0, y - 1); ny <= std::min(heightMap.getMatrixHeight() - 1, y + 1); ny++) {
+            for (int nx = std::max(0, x - 1); nx <= std::min(heightMap.getMatrixWidth() - 1, x + 1); nx++) {
+                if (heightMap.isNoData(nx, ny))
+                    continue;
+                sum += heightMap.getZ(nx, ny);
+                count++;
+            }
+        }
+        change = (static_cast<double>(sum) / count - z) * weight;
+    } else {
+        change = (_mode == RAISE ? step : -step) * weight;
+    }
+
+    long sculpted = std::lround(z + change);
+    sculpted = std::max<long>(INT_MIN, std::min<long>(INT_MAX, sculpted));
+    std::optional<int> noDataValue = heightMap.getNoDataValue();
+    if (noDataValue && sculpted == *noDataValue)
+        return z;
+    return static_cast<int>(sculpted);
+}
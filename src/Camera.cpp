@@ -9,6 +9,7 @@
  */
 
 #include "../includes/Camera.hpp"
+#include "../includes/WorkerPool.hpp"
 #include <cmath>
 #include <iostream>
 
@@ -27,6 +28,8 @@ Camera::Camera(MLXHandler &MLXHandler, Projector *projector, HeightMap &heightMa
     _zoomLevel = 1.0;
     _cameraX = 0;
     _cameraY = 0;
+    _panX = 0;
+    _panY = 0;
     _horizontalOffset = 0;
     _verticalOffset = 0;
     _spacing = 1.0;
@@ -40,6 +43,9 @@ Camera::Camera(MLXHandler &MLXHandler, Projector *projector, HeightMap &heightMa
     _OriginalRotationAngleX = _rotationAngleX;
     _OriginalRotationAngleY = _rotationAngleY;
     _OriginalRotationAngleZ = _rotationAngleZ;
+
+    updateRotation();
+    invalidateBounds();
     
     calculateInitialScale();
     calculateOffset();
@@ -79,67 +85,56 @@ double Camera::getSpacing() const {
  * @brief Zooms the camera in or out by a given factor.
  * 
  * If a mouse position is provided, the zoom centers on that point to maintain
- * its screen position after scaling. Otherwise, it zooms toward the center.
+ * its screen position after scaling. Otherwise, it zooms toward the center of
+ * the screen, which stays put however far the view has been panned.
  *
  * @param factor Zoom factor (values >1 zoom in, <1 zoom out).
  * @param mouseX X coordinate of the mouse on screen, or -1 if unused.
  * @param mouseY Y coordinate of the mouse on screen, or -1 if unused.
  */
 void Camera::zoom(double factor, int mouseX, int mouseY) {
-    if (mouseX >= 0 && mouseY >= 0) {
-        double worldX = (mouseX - _MLXHandler.getWidth() / 2) / _zoomLevel + _cameraX;
-        double worldY = (mouseY - _MLXHandler.getHeight() / 2) / _zoomLevel + _cameraY;
+    if (mouseX < 0 || mouseY < 0) {
+        mouseX = _MLXHandler.getWidth() / 2;
+        mouseY = _MLXHandler.getHeight() / 2;
+    }
 
-        _zoomLevel *= factor;
+    double worldX = (mouseX - _MLXHandler.getWidth() / 2 - _panX) / _zoomLevel + _cameraX;
+    double worldY = (mouseY - _MLXHandler.getHeight() / 2 - _panY) / _zoomLevel + _cameraY;
 
-        _zoomLevel = std::max(0.1, std::min(_zoomLevel, 10.0));
-        
-        _cameraX = worldX - (mouseX - _MLXHandler.getWidth() / 2) / _zoomLevel;
-        _cameraY = worldY - (mouseY - _MLXHandler.getHeight() / 2) / _zoomLevel;
-    } else {
-        _zoomLevel *= factor;
-        _zoomLevel = std::max(0.1, std::min(_zoomLevel, 10.0));
-    }
+    _zoomLevel *= factor;
+
+    _zoomLevel = std::max(0.1, std::min(_zoomLevel, 10.0));
+
+    _cameraX = worldX - (mouseX - _MLXHandler.getWidth() / 2 - _panX) / _zoomLevel;
+    _cameraY = worldY - (mouseY - _MLXHandler.getHeight() / 2 - _panY) / _zoomLevel;
 }
 
 /**
  * @brief Moves the camera position by a given offset.
  * 
- * Pan movement is adjusted by the current zoom level for intuitive navigation.
+ * Pan is kept in whole screen pixels, independent of zoom, so a pan of (dx, dy)
+ * translates every projected point by exactly (-dx, -dy). This lets the renderer
+ * scroll the previous frame instead of redrawing it.
  *
  * @param dx Horizontal movement in screen coordinates.
  * @param dy Vertical movement in screen coordinates.
  */
 void Camera::pan(int dx, int dy) {
-    _cameraX += dx / _zoomLevel;
-    _cameraY += dy / _zoomLevel;
+    _panX -= dx;
+    _panY -= dy;
 }
 
 /**
  * @brief Centers the rendered map within the screen.
  *
- * Calculates the bounding box of the projected heightmap and computes the
+ * Uses the (cached) bounding box of the projected heightmap and computes the
  * necessary offsets to center it on screen, resetting the camera position
  * in the process.
  */
 void Camera::centerCamera() {
-    int minX = INT_MAX, minY = INT_MAX;
-    int maxX = INT_MIN, maxY = INT_MIN;
-    
-    for (int y = 0; y < _heightMap.getMatrixHeight(); y++) {
-        for (int x = 0; x < _heightMap.getMatrixWidth(); x++) {
-            int z = _heightMap.getZ(x, y);
-            int drawX = x * _spacing;
-            int drawY = y * _spacing;
-            
-            std::pair<int, int> projectedPoint = _projector->getProjection()->project(drawX, drawY, z);
-            
-            minX = std::min(minX, projectedPoint.first);
-            minY = std::min(minY, projectedPoint.second);
-            maxX = std::max(maxX, projectedPoint.first);
-            maxY = std::max(maxY, projectedPoint.second);
-        }
-    }
+    const ProjectedBounds &bounds = getProjectedBounds();
+    int minX = bounds.minX, minY = bounds.minY;
+    int maxX = bounds.maxX, maxY = bounds.maxY;
 
     int mapCenterX = (minX + maxX) / 2;
     int mapCenterY = (minY + maxY) / 2;
@@ -152,36 +147,22 @@ void Camera::centerCamera() {
     
     _cameraX = 0;
     _cameraY = 0;
+    _panX = 0;
+    _panY = 0;
 }
 
 /**
  * @brief Calculates screen-space offsets to center the projected map.
  *
- * Projects each point in the heightmap to determine its bounds,
- * then sets horizontal and vertical offsets so that the entire map
- * appears centered in the window.
+ * Uses the (cached) bounds of the projected heightmap to set horizontal
+ * and vertical offsets so that the entire map appears centered in the window.
  */
-
 void Camera::calculateOffset() {
-    int minX = INT_MAX;
-    int maxX = INT_MIN;
-    int minY = INT_MAX;
-    int maxY = INT_MIN;
-    
-    for (int y = 0; y < _heightMap.getMatrixHeight(); y++) {
-        for (int x = 0; x < _heightMap.getMatrixWidth(); x++) {
-            int z = _heightMap.getZ(x, y);
-            int drawX = x * _spacing;
-            int drawY = y * _spacing;
-            
-            std::pair<int, int> projectedPoint = _projector->getProjection()->project(drawX, drawY, z);
-            
-            minX = std::min(minX, projectedPoint.first);
-            maxX = std::max(maxX, projectedPoint.first);
-            minY = std::min(minY, projectedPoint.second);
-            maxY = std::max(maxY, projectedPoint.second);
-        }
-    }
+    const ProjectedBounds &bounds = getProjectedBounds();
+    int minX = bounds.minX;
+    int maxX = bounds.maxX;
+    int minY = bounds.minY;
+    int maxY = bounds.maxY;
     
     int projectedWidth = maxX - minX;
     int projectedHeight = maxY - minY;
@@ -190,6 +171,105 @@ void Camera::calculateOffset() {
     _verticalOffset = ((_MLXHandler.getHeight() - projectedHeight) / 2) - minY;
 }
 
+/**
+ * @brief Returns the projected bounds of the map for the active projection.
+ *
+ * Bounds are cached per projection and recomputed only when the spacing or the
+ * Z factor changed since they were last computed, so holding a projection key
+ * or switching back and forth between projections does not rescan the map.
+ *
+ * @return Bounds of every grid point projected without rotation, zoom or pan.
+ */
+const Camera::ProjectedBounds &Camera::getProjectedBounds() {
+    ProjectedBounds &bounds = _boundsCache[_projector->getType() - 1];
+
+    if (!bounds.valid || bounds.spacing != _spacing || bounds.zFactor != _heightMap.getZFactor()) {
+        computeProjectedBounds(bounds);
+        bounds.spacing = _spacing;
+        bounds.zFactor = _heightMap.getZFactor();
+        bounds.valid = true;
+    }
+    return bounds;
+}
+
+/**
+ * @brief Projects every grid point to compute the map's 2D bounds.
+ *
+ * Rows are split into bands scanned on the shared worker pool; each band keeps
+ * its own extrema, merged once all bands are done.
+ *
+ * @param bounds Entry receiving the computed extrema.
+ */
+void Camera::computeProjectedBounds(ProjectedBounds &bounds) const {
+    std::visit([&](const auto &projection) {
+        computeProjectedBounds(projection, bounds);
+    }, _projector->getProjection());
+}
+
+/**
+ * @brief Scans the grid with a concrete projection; see computeProjectedBounds().
+ *
+ * @param projection Projection used for every point.
+ * @param bounds Entry receiving the computed extrema.
+ */
+template <typename P>
+void Camera::computeProjectedBounds(const P &projection, ProjectedBounds &bounds) const {
+    int height = _heightMap.getMatrixHeight();
+    int width = _heightMap.getMatrixWidth();
+    double zFactor = _heightMap.getZFactor();
+
+    int nThreads = std::max(1, std::min(WorkerPool::shared().getThreadCount(), height / 64));
+
+    std::vector<ProjectedBounds> bands(nThreads);
+
+    auto scanBand = [&](int band) {
+        ProjectedBounds &local = bands[band];
+        local.minX = INT_MAX;
+        local.minY = INT_MAX;
+        local.maxX = INT_MIN;
+        local.maxY = INT_MIN;
+
+        int rowEnd = static_cast<long>(height) * (band + 1) / nThreads;
+        for (int y = static_cast<long>(height) * band / nThreads; y < rowEnd; y++) {
+            for (int x = 0; x < width; x++) {
+                int z = _heightMap.getZ(x, y) * zFactor;
+                int drawX = x * _spacing;
+                int drawY = y * _spacing;
+
+                std::pair<int, int> projectedPoint = projection.project(drawX, drawY, z);
+
+                local.minX = std::min(local.minX, projectedPoint.first);
+                local.minY = std::min(local.minY, projectedPoint.second);
+                local.maxX = std::max(local.maxX, projectedPoint.first);
+                local.maxY = std::max(local.maxY, projectedPoint.second);
+            }
+        }
+    };
+
+    WorkerPool::shared().run(nThreads, scanBand);
+
+    bounds.minX = INT_MAX;
+    bounds.minY = INT_MAX;
+    bounds.maxX = INT_MIN;
+    bounds.maxY = INT_MIN;
+    for (const ProjectedBounds &band : bands) {
+        bounds.minX = std::min(bounds.minX, band.minX);
+        bounds.minY = std::min(bounds.minY, band.minY);
+        bounds.maxX = std::max(bounds.maxX, band.maxX);
+        bounds.maxY = std::max(bounds.maxY, band.maxY);
+    }
+}
+
+/**
+ * @brief Drops every cached projected bound, forcing a rescan on next use.
+ *
+ * Needed whenever the height data itself changes.
+ */
+void Camera::invalidateBounds() {
+    for (ProjectedBounds &bounds : _boundsCache)
+        bounds.valid = false;
+}
+
 /**
  * @brief Computes initial spacing and adjusts Z-factor based on map dimensions.
  * 
@@ -198,21 +278,10 @@ void Camera::calculateOffset() {
  * horizontal dimensions, adapting to both wide and tall maps.
  */
 void Camera::calculateInitialScale() {
-    double maxWindowDimension = std::min(_MLXHandler.getWidth(), _MLXHandler.getHeight()) * 0.8;
-    double mapDimension = std::max(_heightMap.getMatrixWidth(), _heightMap.getMatrixHeight());
+    _spacing = fittedSpacing();
     
-    _spacing = maxWindowDimension / mapDimension;
-    
-    int minZ = INT_MAX;
-    int maxZ = INT_MIN;
-    
-    for (int y = 0; y < _heightMap.getMatrixHeight(); y++) {
-        for (int x = 0; x < _heightMap.getMatrixWidth(); x++) {
-            int z = _heightMap.getMatrix()[y][x];
-            minZ = std::min(minZ, z);
-            maxZ = std::max(maxZ, z);
-        }
-    }
+    int minZ = _heightMap.getMinHeight();
+    int maxZ = _heightMap.getMaxHeight();
     
     int zRange = maxZ - minZ;
     if (zRange > 0) {
@@ -243,76 +312,109 @@ void Camera::calculateInitialScale() {
     }
 }
 
+/**
+ * @brief Returns the spacing at which the longer side of the map spans 80% of the window.
+ */
+double Camera::fittedSpacing() const {
+    double maxWindowDimension = std::min(_MLXHandler.getWidth(), _MLXHandler.getHeight()) * 0.8;
+    double mapDimension = std::max(_heightMap.getMatrixWidth(), _heightMap.getMatrixHeight());
+
+    return maxWindowDimension / mapDimension;
+}
+
+/**
+ * @brief Refits the camera to a height map whose grid size changed, keeping the view.
+ *
+ * Only the spacing and the centering offsets follow the new grid, so a finer
+ * version of the same map lands where the coarser one was. Zoom, pan, rotation
+ * and the Z factor, which is already in screen units, are left as they are.
+ */
+void Camera::fitHeightMap() {
+    _spacing = fittedSpacing();
+    invalidateBounds();
+    calculateOffset();
+}
+
 /**
  * @brief Transforms world coordinates to screen-space using projection and camera state.
  * 
- * Applies spacing, rotation (X, Y, Z), and current zoom/pan values to convert
- * a 3D point in the heightmap into its final 2D screen position.
+ * Applies spacing, Z scaling, rotation (X, Y, Z), and current zoom/pan values to
+ * convert a 3D point in the heightmap into its final 2D screen position, using the
+ * active projection. Dispatches on the projection variant for every call.
  *
  * @param x X coordinate in the height map grid.
  * @param y Y coordinate in the height map grid.
- * @param z Height value (Z-axis) at the given grid point.
+ * @param z Raw height value (Z-axis) at the given grid point.
  * @return A pair of integers representing the screen X and Y coordinates.
  */
 std::pair<int, int> Camera::worldToScreen(int x, int y, int z) const {
-    int drawX = x * _spacing;
-    int drawY = y * _spacing;
-    int drawZ = z;
-    
-    int centerX = _heightMap.getMatrixWidth() / 2 * _spacing;
-    int centerY = _heightMap.getMatrixHeight() / 2 * _spacing;
-    int centerZ = 0;
+    return std::visit([&](const auto &projection) {
+        return worldToScreen(projection, x, y, z);
+    }, _projector->getProjection());
+}
 
-    drawX -= centerX;
-    drawY -= centerY;
-    drawZ -= centerZ;
-    
-    int originalX = drawX;
-    int originalY = drawY;
-    int originalZ = drawZ;
-
-    if (_rotationAngleX != 0.0) {
-        double cosX = cos(_rotationAngleX);
-        double sinX = sin(_rotationAngleX);
-        drawY = round(originalY * cosX - originalZ * sinX);
-        drawZ = round(originalY * sinX + originalZ * cosX);
-        
-        originalY = drawY;
-        originalZ = drawZ;
-    }
-    
-    if (_rotationAngleY != 0.0) {
-        double cosY = cos(_rotationAngleY);
-        double sinY = sin(_rotationAngleY);
-        drawX = round(originalX * cosY + originalZ * sinY);
-        drawZ = round(-originalX * sinY + originalZ * cosY);
-        
-        originalX = drawX;
-    }
-    
-    if (_rotationAngleZ != 0.0) {
-        double cosZ = cos(_rotationAngleZ);
-        double sinZ = sin(_rotationAngleZ);
-        drawX = round(originalX * cosZ - originalY * sinZ);
-        drawY = round(originalX * sinZ + originalY * cosZ);
-    }
+/**
+ * @brief Computes the screen bounds of a grid-space box.
+ *
+ * Projects the eight corners of the box. The bounds enclose the whole box as
+ * long as the projection keeps straight lines straight and, for perspective,
+ * the box lies in front of the near plane; the call fails otherwise.
+ *
+ * @param x0 Lowest X grid coordinate of the box.
+ * @param y0 Lowest Y grid coordinate of the box.
+ * @param z0 One raw Z bound of the box.
+ * @param x1 Highest X grid coordinate of the box.
+ * @param y1 Highest Y grid coordinate of the box.
+ * @param z1 The other raw Z bound of the box.
+ * @param rect Set to the bounds, not clipped to the window.
+ * @return False under curved projections, or if a corner of the box lies behind
+ *         the near plane; rect is then unspecified.
+ */
+bool Camera::boxScreenRect(int x0, int y0, int z0, int x1, int y1, int z1, ScreenRect &rect) const {
+    return std::visit([&](const auto &projection) {
+        if constexpr (std::decay_t<decltype(projection)>::IS_CURVED) {
+            return false;
+        } else {
+            rect = {INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+            for (int corner = 0; corner < 8; corner++) {
+                CameraPoint point = toCameraSpace((corner & 1) ? x1 : x0, (corner & 2) ? y1 : y0, (corner & 4) ? z1 : z0);
+                if (!isInFront(projection, point))
+                    return false;
+                std::pair<int, int> screen = cameraToScreen(projection, point);
+                rect.x0 = std::min(rect.x0, screen.first);
+                rect.y0 = std::min(rect.y0, screen.second);
+                rect.x1 = std::max(rect.x1, screen.first + 1);
+                rect.y1 = std::max(rect.y1, screen.second + 1);
+            }
+            return true;
+        }
+    }, _projector->getProjection());
+}
 
-    drawX += centerX;
-    drawY += centerY;
-    drawZ += centerZ;
+/**
+ * @brief Tests whether a grid-space box can touch a screen region.
+ *
+ * Compares the box's screen bounds (see boxScreenRect()), widened by the margin,
+ * against the region. Boxes whose bounds are unknown, under curved projections
+ * or crossing the near plane, are reported as visible.
+ *
+ * @param x0 Lowest X grid coordinate of the box.
+ * @param y0 Lowest Y grid coordinate of the box.
+ * @param z0 One raw Z bound of the box.
+ * @param x1 Highest X grid coordinate of the box.
+ * @param y1 Highest Y grid coordinate of the box.
+ * @param z1 The other raw Z bound of the box.
+ * @param margin Extra pixels tolerated around the projected bounds.
+ * @param rect Screen region to test against.
+ * @return False only if the whole box is guaranteed to land outside the region.
+ */
+bool Camera::isBoxInRect(int x0, int y0, int z0, int x1, int y1, int z1, int margin, const ScreenRect &rect) const {
+    ScreenRect bounds;
+    if (!boxScreenRect(x0, y0, z0, x1, y1, z1, bounds))
+        return true;
 
-    std::pair<int, int> projectedPoint = _projector->getProjection()->project(drawX, drawY, drawZ);
-    
-    int centeredX = projectedPoint.first + _horizontalOffset;
-    int centeredY = projectedPoint.second + _verticalOffset;
-    
-    int screenCenterX = _MLXHandler.getWidth() / 2;
-    int screenCenterY = _MLXHandler.getHeight() / 2;
-    
-    int screenX = screenCenterX + ((centeredX - screenCenterX) - _cameraX) * _zoomLevel;
-    int screenY = screenCenterY + ((centeredY - screenCenterY) - _cameraY) * _zoomLevel;
-    
-    return {screenX, screenY};
+    return bounds.x1 - 1 + margin >= rect.x0 && bounds.x0 - margin < rect.x1 &&
+           bounds.y1 - 1 + margin >= rect.y0 && bounds.y0 - margin < rect.y1;
 }
 
 /**
@@ -331,18 +433,36 @@ void Camera::rotateX(double angle) {
     _rotationAngleX += angle;
     while (_rotationAngleX >= 2 * M_PI) _rotationAngleX -= 2 * M_PI;
     while (_rotationAngleX < 0) _rotationAngleX += 2 * M_PI;
+    updateRotation();
 }
 
 void Camera::rotateY(double angle) {
     _rotationAngleY += angle;
     while (_rotationAngleY >= 2 * M_PI) _rotationAngleY -= 2 * M_PI;
     while (_rotationAngleY < 0) _rotationAngleY += 2 * M_PI;
+    updateRotation();
 }
 
 void Camera::rotateZ(double angle) {
     _rotationAngleZ += angle;
     while (_rotationAngleZ >= 2 * M_PI) _rotationAngleZ -= 2 * M_PI;
     while (_rotationAngleZ < 0) _rotationAngleZ += 2 * M_PI;
+    updateRotation();
+}
+
+/**
+ * @brief Caches the sine and cosine of each rotation angle.
+ *
+ * toCameraSpace() runs for every vertex of every frame, while the angles only
+ * change on rotation input.
+ */
+void Camera::updateRotation() {
+    _cosX = cos(_rotationAngleX);
+    _sinX = sin(_rotationAngleX);
+    _cosY = cos(_rotationAngleY);
+    _sinY = sin(_rotationAngleY);
+    _cosZ = cos(_rotationAngleZ);
+    _sinZ = sin(_rotationAngleZ);
 }
 
 double Camera::getRotationAngleX() const {
@@ -357,6 +477,10 @@ double Camera::getRotationAngleZ() const {
     return _rotationAngleZ;
 }
 
+Projector *Camera::getProjector() const {
+    return _projector;
+}
+
 /**
  * @brief Resets the camera to its initial state.
  *
@@ -367,10 +491,13 @@ void Camera::reset(){
     _zoomLevel = _OriginalZoomLevel;
     _cameraX = _OriginalCameraX;
     _cameraY = _OriginalCameraY;
+    _panX = 0;
+    _panY = 0;
     _horizontalOffset = _OriginalHorizontalOffset;
     _verticalOffset = _OriginalVerticalOffset;
     _spacing = _OriginalSpacing;
     _rotationAngleX = _OriginalRotationAngleX;
     _rotationAngleY = _OriginalRotationAngleY;
     _rotationAngleZ = _OriginalRotationAngleZ;
+    updateRotation();
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
  */
 
 #include "../includes/ColorManager.hpp"
+#include "../includes/WorkerPool.hpp"
+#include <cmath>
 
 /**
  * @brief Constructs a ColorManager for the given height map.
@@ -16,7 +18,9 @@
  * @param heightMap Reference to the HeightMap used for determining heights and custom colors.
  */
 ColorManager::ColorManager(HeightMap &heightMap) 
-    : _heightMap(heightMap), _selectedColors(_colors1), _currentColorSet(0) {}
+    : _heightMap(heightMap), _selectedColors(_colors1), _currentColorSet(0),
+      _equalized(false), _lighting(false), _lightAzimuth(-M_PI / 4), _lightAltitude(M_PI / 4),
+      _shadesValid(false), _shadedZFactor(0.0), _dirtyX0(0), _dirtyY0(0), _dirtyX1(0), _dirtyY1(0) {}
 
 /**
  * @brief Destructor for ColorManager.
@@ -27,9 +31,10 @@ ColorManager::~ColorManager() {
 /**
  * @brief Computes the final color for a heightmap point based on its height.
  * 
- * If the point has a custom color defined in the height map, that color is returned.
- * Otherwise, the height is normalized and used to interpolate between two neighboring
- * colors in the active palette.
+ * If the point has a custom color defined in the height map, that color is returned
+ * as written in the map file. Otherwise, the height is normalized (linearly, or by
+ * histogram equalization when enabled) and used to interpolate between two
+ * neighboring colors in the active palette, and the hillshade is applied when enabled.
  * 
  * @param x X coordinate in the height map.
  * @param y Y coordinate in the height map.
@@ -41,7 +46,7 @@ int ColorManager::getColorFromHeight(int x, int y, int z) {
         return _heightMap.getColor(x, y);
     }
     
-    float normalized = _heightMap.normalizeHeight(z);
+    float normalized = _equalized ? _heightMap.equalizeHeight(z) : _heightMap.normalizeHeight(z);
     
     normalized = std::max(0.0f, std::min(1.0f, normalized));
     
@@ -52,7 +57,165 @@ int ColorManager::getColorFromHeight(int x, int y, int z) {
     
     float localT = (normalized * (COLOR_COUNT - 1)) - segment;
     
-    return interpolateColor(colorA, colorB, localT);
+    return applyShade(interpolateColor(colorA, colorB, localT), x, y);
+}
+
+/**
+ * @brief Switches between linear and histogram-equalized height coloring.
+ *
+ * @param status True to spread the palette by height frequency instead of range.
+ */
+void ColorManager::setEqualizedStatus(bool status) {
+    _equalized = status;
+}
+
+bool ColorManager::getEqualizedStatus() const {
+    return _equalized;
+}
+
+/**
+ * @brief Turns hillshading of the height colors on or off.
+ *
+ * @param status True to darken each vertex by its cached shade.
+ */
+void ColorManager::setLightingStatus(bool status) {
+    _lighting = status;
+}
+
+bool ColorManager::getLightingStatus() const {
+    return _lighting;
+}
+
+/**
+ * @brief Swings the sun around the vertical axis.
+ *
+ * The shade cache is rebuilt on the next lit lookup.
+ *
+ * @param angle Azimuth change in radians.
+ */
+void ColorManager::rotateLight(double angle) {
+    _lightAzimuth = std::remainder(_lightAzimuth + angle, 2 * M_PI);
+    _shadesValid = false;
+}
+
+/**
+ * @brief Marks every shade stale, e.g. after the height map was replaced.
+ */
+void ColorManager::invalidateShades() {
+    _shadesValid = false;
+}
+
+/**
+ * @brief Marks the shades of a rectangle of vertices stale, e.g. after heights changed.
+ *
+ * Successive rectangles are merged into their bounding box, which is re-shaded
+ * on the next lit lookup. Nothing is recorded while a full rebuild is pending.
+ *
+ * @param x0 First stale column.
+ * @param y0 First stale row.
+ * @param x1 Column past the last stale one.
+ * @param y1 Row past the last stale one.
+ */
+void ColorManager::invalidateShades(int x0, int y0, int x1, int y1) {
+    if (!_shadesValid || x0 >= x1 || y0 >= y1)
+        return;
+    if (_dirtyX0 >= _dirtyX1) {
+        _dirtyX0 = x0;
+        _dirtyY0 = y0;
+        _dirtyX1 = x1;
+        _dirtyY1 = y1;
+        return;
+    }
+    _dirtyX0 = std::min(_dirtyX0, x0);
+    _dirtyY0 = std::min(_dirtyY0, y0);
+    _dirtyX1 = std::max(_dirtyX1, x1);
+    _dirtyY1 = std::max(_dirtyY1, y1);
+}
+
+double ColorManager::getLightAzimuth() const {
+    return _lightAzimuth;
+}
+
+/**
+ * @brief Scales the RGB channels of a color by the vertex's cached shade.
+ *
+ * Returns the color unchanged while lighting is off. The cache depends on the
+ * light direction and the Z factor, so it is rebuilt when one of those
+ * changed since the last lookup rather than every frame; height changes only
+ * re-shade their stale rectangle.
+ *
+ * @param color Unlit color (as 0xRRGGBBAA).
+ * @param x X coordinate in the height map.
+ * @param y Y coordinate in the height map.
+ * @return The shaded color, alpha untouched.
+ */
+int ColorManager::applyShade(int color, int x, int y) {
+    if (!_lighting)
+        return color;
+    if (!_shadesValid || _shadedZFactor != _heightMap.getZFactor())
+        updateShades(0, 0, _heightMap.getMatrixWidth(), _heightMap.getMatrixHeight());
+    else if (_dirtyX0 < _dirtyX1)
+        updateShades(_dirtyX0, _dirtyY0, _dirtyX1, _dirtyY1);
+
+    uint32_t shade = _shades[static_cast<size_t>(y) * _heightMap.getMatrixWidth() + x];
+    uint32_t value = static_cast<uint32_t>(color);
+    uint32_t r = ((value >> 24) & 0xFF) * shade / 255;
+    uint32_t g = ((value >> 16) & 0xFF) * shade / 255;
+    uint32_t b = ((value >> 8) & 0xFF) * shade / 255;
+
+    return static_cast<int>((r << 24) | (g << 16) | (b << 8) | (value & 0xFF));
+}
+
+/**
+ * @brief Recomputes the Lambertian shade of a rectangle of vertices from their slopes.
+ *
+ * Normals come from HeightMap's slopes scaled by the current Z factor.
+ * Shades are stored as 0-255 with an ambient floor, so faces turned away from
+ * the sun stay readable. Rows are split into bands shaded on the worker pool.
+ * Every stale mark is cleared afterwards, so callers pass a rectangle covering them.
+ *
+ * @param x0 First column.
+ * @param y0 First row.
+ * @param x1 Column past the last one.
+ * @param y1 Row past the last one.
+ */
+void ColorManager::updateShades(int x0, int y0, int x1, int y1) {
+    int width = _heightMap.getMatrixWidth();
+    int height = _heightMap.getMatrixHeight();
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, width);
+    y1 = std::min(y1, height);
+    float zFactor = _heightMap.getZFactor();
+    float lightX = std::cos(_lightAltitude) * std::cos(_lightAzimuth);
+    float lightY = std::cos(_lightAltitude) * std::sin(_lightAzimuth);
+    float lightZ = std::sin(_lightAltitude);
+
+    _shades.resize(static_cast<size_t>(width) * height);
+
+    int nThreads = std::max(1, std::min(WorkerPool::shared().getThreadCount(), (y1 - y0) / 64));
+
+    auto shadeBand = [&](int band) {
+        int rowEnd = y0 + static_cast<long>(y1 - y0) * (band + 1) / nThreads;
+        for (int y = y0 + static_cast<long>(y1 - y0) * band / nThreads; y < rowEnd; y++) {
+            uint8_t *shade = &_shades[static_cast<size_t>(y) * width];
+            for (int x = x0; x < x1; x++) {
+                const HeightMap::Slope &slope = _heightMap.getSlope(x, y);
+                float normalX = -slope.dx * zFactor;
+                float normalY = -slope.dy * zFactor;
+                float lit = (normalX * lightX + normalY * lightY + lightZ) /
+                            std::sqrt(normalX * normalX + normalY * normalY + 1.0f);
+                lit = AMBIENT_LIGHT + (1.0f - AMBIENT_LIGHT) * std::max(0.0f, lit);
+                shade[x] = static_cast<uint8_t>(lit * 255.0f + 0.5f);
+            }
+        }
+    };
+
+    WorkerPool::shared().run(nThreads, shadeBand);
+
+    _shadesValid = true;
+    _shadedZFactor = _heightMap.getZFactor();
+    _dirtyX0 = _dirtyX1 = 0;
 }
 
 /**
@@ -0,0 +1,236 @@
+/**
+ * @file Contours.cpp
+ * @brief Implements the Contours class, a cached marching-squares isoline tracer.
+ *
+ * Contour segments are traced once per interval, in parallel over bands of chunk
+ * rows, and handed to the Renderer chunk by chunk so they follow the same culling
+ * and drawing order as the map itself.
+ */
+
+#include "../includes/Contours.hpp"
+#include "../includes/WorkerPool.hpp"
+#include <cmath>
+
+/**
+ * @brief Constructs the contour cache for a height map.
+ *
+ * Nothing is traced until the first update().
+ *
+ * @param heightMap Height map to trace.
+ */
+Contours::Contours(HeightMap &heightMap)
+    : _heightMap(heightMap), _interval(1), _userInterval(false), _valid(false) {
+    fitInterval();
+}
+
+/**
+ * @brief Destructor for Contours.
+ */
+Contours::~Contours() {}
+
+/**
+ * @brief Picks the default interval for the height map's current range.
+ *
+ * The interval is a round 1, 2 or 5 times a power of ten that splits the height
+ * range into about ten bands. Once the user has chosen an interval through
+ * setInterval(), it is kept instead.
+ */
+void Contours::fitInterval() {
+    if (_userInterval)
+        return;
+    int interval = 1;
+    double step = (_heightMap.getMaxHeight() - _heightMap.getMinHeight()) / 10.0;
+    if (step > 1.0) {
+        double magnitude = std::pow(10.0, std::floor(std::log10(step)));
+        double fraction = step / magnitude;
+        interval = static_cast<int>((fraction < 2.0 ? 1.0 : fraction < 5.0 ? 2.0 : 5.0) * magnitude);
+    }
+    if (interval != _interval) {
+        _interval = interval;
+        _valid = false;
+    }
+}
+
+/**
+ * @brief Sets the height difference between consecutive contour lines.
+ *
+ * The interval is then kept by fitInterval().
+ *
+ * @param interval New interval in raw height units; clamped to at least 1.
+ */
+void Contours::setInterval(int interval) {
+    interval = std::max(1, interval);
+    _userInterval = true;
+    if (interval != _interval) {
+        _interval = interval;
+        _valid = false;
+    }
+}
+
+int Contours::getInterval() const {
+    return _interval;
+}
+
+/**
+ * @brief Marks the cached segments stale, e.g. after heights changed.
+ */
+void Contours::invalidate() {
+    _valid = false;
+}
+
+/**
+ * @brief Retraces the contours if the cache is stale.
+ */
+void Contours::update() {
+    if (!_valid)
+        build();
+}
+
+/**
+ * @brief Returns all cached segments, grouped by chunk.
+ *
+ * The segments of chunk i are [getChunkBegin(i), getChunkEnd(i)).
+ */
+const std::vector<Contours::Segment> &Contours::getSegments() const {
+    return _segments;
+}
+
+/**
+ * @brief Traces every chunk and rebuilds the per-chunk segment ranges.
+ *
+ * Each pool thread traces a band of whole chunk rows into its own list; the lists
+ * are then concatenated in band order, which keeps the chunks in row-major order.
+ * The lists keep their capacity between builds, so retracing after a height
+ * change does not allocate once the contours have been traced.
+ */
+void Contours::build() {
+    const std::vector<HeightMap::Chunk> &chunks = _heightMap.getChunks();
+    int chunkColumns = _heightMap.getChunkColumns();
+    int chunkRows = _heightMap.getChunkRows();
+
+    int nThreads = std::max(1, std::min(WorkerPool::shared().getThreadCount(), chunkRows));
+
+    _bands.resize(nThreads);
+    _counts.resize(chunks.size());
+    auto traceBand = [&](int band) {
+        std::vector<Segment> &segments = _bands[band];
+        segments.clear();
+        int rowEnd = chunkRows * (band + 1) / nThreads;
+        for (int row = chunkRows * band / nThreads; row < rowEnd; row++) {
+            for (int column = 0; column < chunkColumns; column++) {
+                int index = row * chunkColumns + column;
+                size_t before = segments.size();
+                traceChunk(chunks[index], segments);
+                _counts[index] = segments.size() - before;
+            }
+        }
+    };
+
+    WorkerPool::shared().run(nThreads, traceBand);
+
+    _segments.clear();
+    for (int band = 0; band < nThreads; band++)
+        _segments.insert(_segments.end(), _bands[band].begin(), _bands[band].end());
+    _chunkOffsets.resize(chunks.size() + 1);
+    _chunkOffsets[0] = 0;
+    for (size_t chunk = 0; chunk < chunks.size(); chunk++)
+        _chunkOffsets[chunk + 1] = _chunkOffsets[chunk] + _counts[chunk];
+    _valid = true;
+}
+
+/**
+ * @brief Traces the cells whose top-left vertex a chunk owns.
+ *
+ * @param chunk Chunk to trace.
+ * @param out List the segments are appended to.
+ */
+void Contours::traceChunk(const HeightMap::Chunk &chunk, std::vector<Segment> &out) const {
+    int xEnd = std::min(chunk.xEnd, _heightMap.getMatrixWidth() - 1);
+    int yEnd = std::min(chunk.yEnd, _heightMap.getMatrixHeight() - 1);
+
+    for (int y = chunk.y0; y < yEnd; y++) {
+        for (int x = chunk.x0; x < xEnd; x++)
+            traceCell(x, y, out);
+    }
+}
+
+/**
+ * @brief Emits the contour segments crossing the cell at (x, y).
+ *
+ * A corner counts as above a level when its height is at least the level, and
+ * crossings are linearly interpolated along the cell sides. Saddle cells are
+ * resolved with the average of the four corners. Cells touching no-data are
+ * skipped.
+ *
+ * @param x Column of the cell's top-left vertex.
+ * @param y Row of the cell's top-left vertex.
+ * @param out List the segments are appended to.
+ */
+void Contours::traceCell(int x, int y, std::vector<Segment> &out) const {
+    if (_heightMap.isNoData(x, y) || _heightMap.isNoData(x + 1, y) ||
+        _heightMap.isNoData(x, y + 1) || _heightMap.isNoData(x + 1, y + 1))
+        return;
+
+    int topLeft = _heightMap.getZ(x, y);
+    int topRight = _heightMap.getZ(x + 1, y);
+    int bottomRight = _heightMap.getZ(x + 1, y + 1);
+    int bottomLeft = _heightMap.getZ(x, y + 1);
+
+    int low = std::min(std::min(topLeft, topRight), std::min(bottomRight, bottomLeft));
+    int high = std::max(std::max(topLeft, topRight), std::max(bottomRight, bottomLeft));
+    if (low == high)
+        return;
+
+    auto floorDiv = [](int value, int divisor) {
+        return value / divisor - (value % divisor != 0 && value < 0);
+    };
+    auto crossing = [](int from, int to, int level) {
+        return static_cast<float>(level - from) / (to - from);
+    };
+
+    for (int k = floorDiv(low, _interval) + 1; k <= floorDiv(high, _interval); k++) {
+        int level = k * _interval;
+        bool topLeftAbove = topLeft >= level;
+        bool topRightAbove = topRight >= level;
+        bool bottomRightAbove = bottomRight >= level;
+        bool bottomLeftAbove = bottomLeft >= level;
+
+        // Crossings on the top, right, bottom and left sides, in that order.
+        float pointX[4];
+        float pointY[4];
+        int count = 0;
+        if (topLeftAbove != topRightAbove) {
+            pointX[count] = x + crossing(topLeft, topRight, level);
+            pointY[count] = y;
+            count++;
+        }
+        if (topRightAbove != bottomRightAbove) {
+            pointX[count] = x + 1;
+            pointY[count] = y + crossing(topRight, bottomRight, level);
+            count++;
+        }
+        if (bottomLeftAbove != bottomRightAbove) {
+            pointX[count] = x + crossing(bottomLeft, bottomRight, level);
+            pointY[count] = y + 1;
+            count++;
+        }
+        if (topLeftAbove != bottomLeftAbove) {
+            pointX[count] = x;
+            pointY[count] = y + crossing(topLeft, bottomLeft, level);
+            count++;
+        }
+
+        if (count == 2) {
+            out.push_back({pointX[0], pointY[0], pointX[1], pointY[1], level});
+        } else if (count == 4) {
+            bool centerAbove = static_cast<long>(topLeft) + topRight + bottomRight + bottomLeft >= 4L * level;
+            if (centerAbove == topLeftAbove) {
+                out.push_back({pointX[0], pointY[0], pointX[1], pointY[1], level});
+                out.push_back({pointX[2], pointY[2], pointX[3], pointY[3], level});
+            } else {
+                out.push_back({pointX[0], pointY[0], pointX[3], pointY[3], level});
+                out.push_back({pointX[1], pointY[1], pointX[2], pointY[2], level});
+            }
+        }
+    }
+}
@@ -2,7 +2,7 @@
  * @file FDF.cpp
  * @brief Implements the FDF class, which acts as the orchestrator of rendering logic.
  *
- * Connects the HeightMap, Projector, Camera, ColorManager, and Renderer
+ * Connects the HeightMap, Projector, Camera, ColorManager, Contours, and Renderer
  * to enable real-time rendering of a wireframe heightmap.
  */
 
@@ -16,20 +16,45 @@
  * - Projector for 3D projection
  * - Camera for viewport manipulation
  * - ColorManager for height-based coloring
+ * - Contours for the cached isoline overlay
  * - Renderer to draw the final output
  *
  * @param map The parsed string map data.
  * @param projector Pointer to the active Projector.
  * @param MLXHandler Reference to the MLX handler managing the window.
  * @param vfx Pointer to the active visual effects engine.
+ * @param noDataValue Optional height marking cells that should not be drawn.
+ * @param text Arena holding the map's text, released once it is parsed; may be NULL.
  */
-FDF::FDF(std::vector<std::string> &map, Projector *projector, MLXHandler &MLXHandler, VFX *vfx)
-    : _heightMap(map),
+FDF::FDF(const std::vector<std::string_view> &map, Projector *projector, MLXHandler &MLXHandler, VFX *vfx,
+         std::optional<int> noDataValue, LoadArena *text)
+    : _heightMap(map, noDataValue, text),
       _projector(projector),
       _vfx(vfx),
       _camera(MLXHandler, projector, _heightMap),
       _colorManager(_heightMap),
-      _renderer(MLXHandler, _heightMap, _camera, _colorManager, vfx) {
+      _contours(_heightMap),
+      _renderer(MLXHandler, _heightMap, _camera, _colorManager, _contours, vfx) {
+}
+
+/**
+ * @brief Constructs the FDF rendering system around an already built height map.
+ *
+ * Lets the height map be loaded on another thread while the window is created.
+ *
+ * @param heightMap Height map to take over.
+ * @param projector Pointer to the active Projector.
+ * @param MLXHandler Reference to the MLX handler managing the window.
+ * @param vfx Pointer to the active visual effects engine.
+ */
+FDF::FDF(HeightMap &&heightMap, Projector *projector, MLXHandler &MLXHandler, VFX *vfx)
+    : _heightMap(std::move(heightMap)),
+      _projector(projector),
+      _vfx(vfx),
+      _camera(MLXHandler, projector, _heightMap),
+      _colorManager(_heightMap),
+      _contours(_heightMap),
+      _renderer(MLXHandler, _heightMap, _camera, _colorManager, _contours, vfx) {
 }
 
 /**
@@ -58,6 +83,14 @@ ColorManager *FDF::getColorManager() {
     return &_colorManager;
 }
 
+Contours *FDF::getContours() {
+    return &_contours;
+}
+
+Renderer *FDF::getRenderer() {
+    return &_renderer;
+}
+
 double FDF::getZFactor() {
     return _heightMap.getZFactor();
 }
@@ -73,6 +106,18 @@ void FDF::draw() {
     _renderer.draw();
 }
 
+/**
+ * @brief Updates the frame after the camera was only panned by (dx, dy).
+ *
+ * Scrolls the previous frame instead of redrawing it whenever possible.
+ *
+ * @param dx Total horizontal pan applied since the last frame.
+ * @param dy Total vertical pan applied since the last frame.
+ */
+void FDF::drawPanned(int dx, int dy) {
+    _renderer.drawScrolled(-dx, -dy);
+}
+
 /**
  * @brief Zooms the camera in or out toward a specific screen point.
  *
@@ -111,6 +156,97 @@ void FDF::setZFactor(double increase, int mode) {
     _heightMap.setZFactor(increase, mode);
 }
 
+/**
+ * @brief Overwrites a rectangle of the map's heights and refreshes what depends on it.
+ *
+ * Shades are redone around the rectangle only, one vertex wider since the
+ * slopes there changed too. The camera keeps its position, so a live stream
+ * can be watched while it runs.
+ *
+ * @param x0 Column of the rectangle's first value.
+ * @param y0 Row of the rectangle's first value.
+ * @param width Columns in the rectangle.
+ * @param height Rows in the rectangle.
+ * @param heights Raw height of (x0, y0).
+ * @param stride Distance between consecutive rows in heights.
+ */
+void FDF::updateRegion(int x0, int y0, int width, int height, const int *heights, size_t stride) {
+    _heightMap.updateRegion(x0, y0, width, height, heights, stride);
+    _camera.invalidateBounds();
+    _colorManager.invalidateShades(x0 - 1, y0 - 1, x0 + width + 1, y0 + height + 1);
+    _contours.invalidate();
+}
+
+/**
+ * @brief Replaces the whole height map, e.g. a preview by a finer one, keeping the view.
+ *
+ * The camera, renderer and color settings stay as they are, and so does the Z
+ * factor; only the spacing and the default contour interval are refitted to the
+ * new map and the caches built from the old heights are dropped.
+ *
+ * @param heightMap Height map to take over.
+ */
+void FDF::setHeightMap(HeightMap &&heightMap) {
+    double zFactor = _heightMap.getZFactor();
+    _heightMap = std::move(heightMap);
+    _heightMap.setZFactor(zFactor - _heightMap.getZFactor(), 1);
+    _camera.fitHeightMap();
+    _colorManager.invalidateShades();
+    _contours.fitInterval();
+    _contours.invalidate();
+}
+
+/**
+ * @brief Applies one brush stroke under a screen position and redraws what it changed.
+ *
+ * The vertex under the position is picked, the stroke's rectangle is written
+ * through updateRegion() and only its screen area is redrawn, two vertices
+ * wider to cover the edges and shading of its neighbors. Tiled maps are not
+ * sculpted: their detail tiles would hide the edits.
+ *
+ * When the stroke moved the map's height range, or equalized colors are on,
+ * every vertex's color may have shifted slightly. The rest of the frame is
+ * still left as is, so strokes keep up with the mouse, and the caller redraws
+ * it once the drag ends.
+ *
+ * @param brush Brush to apply.
+ * @param screenX Screen X coordinate of the cursor.
+ * @param screenY Screen Y coordinate of the cursor.
+ * @return True if colors outside the redrawn area are now outdated.
+ */
+bool FDF::sculpt(Brush &brush, int screenX, int screenY) {
+    int x;
+    int y;
+    Brush::Stroke stroke;
+
+    if (_renderer.getTiledMap() || !_renderer.pickVertex(screenX, screenY, x, y))
+        return false;
+    if (!brush.stroke(_heightMap, x, y, stroke))
+        return false;
+
+    int minHeight = _heightMap.getMinHeight();
+    int maxHeight = _heightMap.getMaxHeight();
+    updateRegion(stroke.x0, stroke.y0, stroke.width, stroke.height, stroke.heights, stroke.width);
+
+    int x0 = std::max(0, stroke.x0 - 2);
+    int y0 = std::max(0, stroke.y0 - 2);
+    int x1 = std::min(_heightMap.getMatrixWidth() - 1, stroke.x0 + stroke.width + 1);
+    int y1 = std::min(_heightMap.getMatrixHeight() - 1, stroke.y0 + stroke.height + 1);
+    int minZ = stroke.minZ;
+    int maxZ = stroke.maxZ;
+    for (y = y0; y <= y1; y++) {
+        for (x = x0; x <= x1; x++) {
+            if (_heightMap.isNoData(x, y))
+                continue;
+            minZ = std::min(minZ, _heightMap.getZ(x, y));
+            maxZ = std::max(maxZ, _heightMap.getZ(x, y));
+        }
+    }
+    _renderer.redrawGridBox(x0, y0, x1, y1, minZ, maxZ);
+    return _heightMap.getMinHeight() != minHeight || _heightMap.getMaxHeight() != maxHeight ||
+           _colorManager.getEqualizedStatus();
+}
+
 /**
  * @brief Rotates the camera around the X-axis.
  * @param angle Angle to rotate in radians.
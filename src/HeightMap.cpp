@@ -7,40 +7,110 @@
  */
 
 #include "../includes/HeightMap.hpp"
+#include "../includes/WorkerPool.hpp"
+#include <cctype>
+#include <charconv>
+#include <exception>
+#include <stdexcept>
 
 /**
  * @brief Constructs a HeightMap from a list of map strings.
  * 
- * Parses height and optional color information for each point, builds
- * the matrix of Z-values, and computes initial metrics such as dimensions
- * and height range.
+ * A first pass counts the points of every row, so each row of map data is
+ * allocated once, at the final width, and parsed in place; empty rows are
+ * dropped and short ones padded with zeros. Both passes run in bands of rows
+ * on the worker pool. The matrix of Z-values and the initial metrics, such as
+ * dimensions, raw height range, per-vertex slopes and the height histogram,
+ * are then built, once the rows' text has been released.
  * 
  * @param map List of strings representing the map rows.
+ * @param noDataValue Height marking cells without data (e.g. -1 in ocean DEMs).
+ *        Those cells are excluded from the height range and never drawn.
+ * @param text Arena holding the rows' text, released as soon as they are
+ *        parsed so it never coexists with the derived data; NULL to keep it.
  */
-HeightMap::HeightMap(std::vector<std::string> &map) : _zFactor(1.0) {
-    _map.getMapData().clear();
-    _minHeight = INT_MAX;
-    _maxHeight = INT_MIN;
-    
-    for (const auto &line : map) {
-        if (!line.empty()) {
-            std::vector<Map::MapPoint> mapLine;
-            parseMapLine(line, mapLine);
-            _map.getMapData().push_back(mapLine);
-        }
+HeightMap::HeightMap(const std::vector<std::string_view> &map, std::optional<int> noDataValue, LoadArena *text)
+    : _zFactor(1.0), _noDataValue(noDataValue) {
+    int nLines = static_cast<int>(map.size());
+    int nThreads = std::max(1, std::min(WorkerPool::shared().getThreadCount(), nLines / 64));
+
+    std::vector<int> counts(nLines);
+    auto countBand = [&](int band) {
+        int lineEnd = static_cast<long>(nLines) * (band + 1) / nThreads;
+        for (int line = static_cast<long>(nLines) * band / nThreads; line < lineEnd; line++)
+            counts[line] = countPoints(map[line]);
+    };
+    WorkerPool::shared().run(nThreads, countBand);
+
+    std::vector<int> lines;
+    lines.reserve(nLines);
+    int maxWidth = 0;
+    for (int line = 0; line < nLines; line++) {
+        if (counts[line] > 0)
+            lines.push_back(line);
+        maxWidth = std::max(maxWidth, counts[line]);
     }
-    
-    size_t maxWidth = 0;
-    for (const auto &row : _map.getMapData()) {
-        maxWidth = std::max(maxWidth, row.size());
+
+    std::vector<Map::MapLine> &mapData = _map.getMapData();
+    mapData.resize(lines.size());
+    int nRows = static_cast<int>(lines.size());
+    std::vector<std::exception_ptr> errors(nThreads);
+
+    auto parseBand = [&](int band) {
+        int rowEnd = static_cast<long>(nRows) * (band + 1) / nThreads;
+        try {
+            for (int row = static_cast<long>(nRows) * band / nThreads; row < rowEnd; row++) {
+                mapData[row].resize(maxWidth);
+                parseMapLine(map[lines[row]], mapData[row].data());
+            }
+        } catch (...) {
+            errors[band] = std::current_exception();
+        }
+    };
+
+    WorkerPool::shared().run(nThreads, parseBand);
+    for (const std::exception_ptr &error : errors) {
+        if (error)
+            std::rethrow_exception(error);
     }
-    
-    for (auto &row : _map.getMapData()) {
-        row.resize(maxWidth, Map::MapPoint(0));
+    if (text != NULL)
+        text->release();
+
+    initialize();
+}
+
+/**
+ * @brief Constructs a HeightMap from an already parsed grid of heights.
+ *
+ * Used for the resident overview of tiled maps. Points get no custom colors.
+ *
+ * @param width Number of columns.
+ * @param height Number of rows.
+ * @param heights width * height raw heights, row-major.
+ * @param noDataValue Height marking cells without data; see the string constructor.
+ */
+HeightMap::HeightMap(int width, int height, const std::vector<int> &heights, std::optional<int> noDataValue)
+    : _zFactor(1.0), _noDataValue(noDataValue) {
+    _map.getMapData().assign(height, Map::MapLine());
+    for (int y = 0; y < height; y++) {
+        Map::MapLine &row = _map.getMapData()[y];
+        row.reserve(width);
+        for (int x = 0; x < width; x++)
+            row.push_back(Map::MapPoint(heights[static_cast<size_t>(y) * width + x]));
     }
-    
-    calculateMinMaxHeight();
-    
+
+    initialize();
+}
+
+/**
+ * @brief Derives everything else from the padded map data.
+ *
+ * Shared by both constructors once _map holds rows of equal width.
+ */
+void HeightMap::initialize() {
+    _matrixHeight = _map.getHeight();
+    _matrixWidth = _map.getWidth();
+
     _matrix.resize(_map.getMapData().size());
     for (size_t y = 0; y < _map.getMapData().size(); y++) {
         _matrix[y].resize(_map.getMapData()[y].size());
@@ -50,11 +120,95 @@ HeightMap::HeightMap(std::vector<std::string> &map) : _zFactor(1.0) {
     }
 
     _zFactor = 1.0;
-    _matrixHeight = _matrix.size();
-    _matrixWidth = _matrix[0].size();
 
     _nPoints = getNPoints();
     _nEdges = getNEdges();
+
+    buildNoDataMask();
+    calculateMinMaxHeight();
+    buildChunks();
+    buildSlopes();
+    buildHistogram();
+}
+
+/**
+ * @brief Overwrites a rectangle of heights and refreshes only what depends on it.
+ *
+ * Instead of rebuilding the whole map, only these are recomputed:
+ * - the no-data flags of the rectangle;
+ * - the height ranges of the chunks it touches;
+ * - the global range, taken from the chunk ranges;
+ * - the slopes of the rectangle grown by one vertex;
+ * - the histogram counts of the changed cells.
+ *
+ * Two cases still do full work. The histogram is rebuilt when the global range
+ * changes, since its bins span that range. The edge list is rebuilt when a cell
+ * enters or leaves no-data. Colors are computed from heights at draw time, so
+ * they follow without further work. Users holding their own caches (contours,
+ * shades, projected bounds) must invalidate them.
+ *
+ * @param x0 Column of the rectangle's first value.
+ * @param y0 Row of the rectangle's first value.
+ * @param width Columns in the rectangle.
+ * @param height Rows in the rectangle.
+ * @param heights Raw height of (x0, y0); the rectangle is clipped to the grid.
+ * @param stride Distance between consecutive rows in heights.
+ */
+void HeightMap::updateRegion(int x0, int y0, int width, int height, const int *heights, size_t stride) {
+    int xBegin = std::max(x0, 0);
+    int yBegin = std::max(y0, 0);
+    int xEnd = std::min(x0 + width, _matrixWidth);
+    int yEnd = std::min(y0 + height, _matrixHeight);
+    if (xBegin >= xEnd || yBegin >= yEnd)
+        return;
+
+    std::vector<Map::MapLine> &mapData = _map.getMapData();
+    int oldMin = _minHeight;
+    int oldMax = _maxHeight;
+    bool topologyChanged = false;
+
+    for (int y = yBegin; y < yEnd; y++) {
+        const int *row = heights + static_cast<size_t>(y - y0) * stride - x0;
+        for (int x = xBegin; x < xEnd; x++) {
+            int z = row[x];
+            bool noData = _noDataValue && z == *_noDataValue;
+
+            if (!isNoData(x, y))
+                _histogram[histogramBin(_matrix[y][x])]--;
+            if (!noData && z >= oldMin && z <= oldMax)
+                _histogram[histogramBin(z)]++;
+            if (noData != isNoData(x, y)) {
+                _noDataMask[static_cast<size_t>(y) * _matrixWidth + x] = noData;
+                topologyChanged = true;
+            }
+            mapData[y][x].z = z;
+            _matrix[y][x] = z;
+        }
+    }
+
+    // Chunks own [x0, xMax] x [y0, yMax], so the one left of or above the
+    // rectangle may share its first column or row.
+    for (int row = std::max(0, (yBegin - 1) / CHUNK_SIZE); row <= (yEnd - 1) / CHUNK_SIZE; row++) {
+        for (int column = std::max(0, (xBegin - 1) / CHUNK_SIZE); column <= (xEnd - 1) / CHUNK_SIZE; column++) {
+            Chunk &chunk = _chunks[row * _chunkColumns + column];
+            if (chunk.xMax >= xBegin && chunk.yMax >= yBegin)
+                measureChunk(chunk);
+        }
+    }
+    if (topologyChanged)
+        buildEdgeList();
+
+    calculateMinMaxFromChunks();
+
+    for (int y = std::max(0, yBegin - 1); y < std::min(_matrixHeight, yEnd + 1); y++) {
+        for (int x = std::max(0, xBegin - 1); x < std::min(_matrixWidth, xEnd + 1); x++)
+            _slopes[static_cast<size_t>(y) * _matrixWidth + x] = computeSlope(x, y);
+    }
+
+    if (_minHeight != oldMin || _maxHeight != oldMax)
+        buildHistogram();
+    else
+        buildEqualization();
 }
 
 /**
@@ -62,6 +216,21 @@ HeightMap::HeightMap(std::vector<std::string> &map) : _zFactor(1.0) {
  */
 HeightMap::~HeightMap() {}
 
+/**
+ * @brief Counts the whitespace-separated points of a map line.
+ */
+int HeightMap::countPoints(std::string_view line) {
+    int count = 0;
+    bool inPoint = false;
+
+    for (char c : line) {
+        bool space = std::isspace(static_cast<unsigned char>(c));
+        count += !space && !inPoint;
+        inPoint = !space;
+    }
+    return count;
+}
+
 /**
  * @brief Parses a line of the map into points with height and optional color.
  * 
@@ -69,59 +238,367 @@ HeightMap::~HeightMap() {}
  * - just a Z value: `"5"`
  * - or a Z and color: `"10,0xFF0000"`
  *
- * Updates the min/max height while parsing.
+ * Anything after the number that is not a color is ignored. Called from several
+ * threads at once, so it only touches the output row.
  *
  * @param line String line from the map.
- * @param points Output vector to be filled with parsed points.
+ * @param points Output row, with room for every point counted by countPoints().
+ * @throws std::invalid_argument if a token does not start with a number or its
+ *         height does not fit in an int.
  */
-void HeightMap::parseMapLine(const std::string &line, std::vector<Map::MapPoint> &points) {
-    std::istringstream iss(line);
-    std::string token;
-    
-    while (iss >> token) {
-        int z = 0;
+void HeightMap::parseMapLine(std::string_view line, Map::MapPoint *points) {
+    const char *cursor = line.data();
+    const char *end = cursor + line.size();
+
+    while (true) {
+        while (cursor < end && std::isspace(static_cast<unsigned char>(*cursor)))
+            cursor++;
+        if (cursor == end)
+            break;
+
+        long z = 0;
+        std::from_chars_result parsed = std::from_chars(cursor + (*cursor == '+'), end, z);
+        if (parsed.ec != std::errc() || z < INT_MIN || z > INT_MAX)
+            throw std::invalid_argument("Bad map value: " + std::string(line.substr(cursor - line.data(), 16)));
+        cursor = parsed.ptr;
+
         int color = 0;
         bool hasCustomColor = false;
-        
-        size_t commaPos = token.find(',');
-        if (commaPos != std::string::npos) {
-            std::string zStr = token.substr(0, commaPos);
-            z = std::stoi(zStr);
-            
-            std::string colorStr = token.substr(commaPos + 1);
-            if (colorStr.substr(0, 2) == "0x" || colorStr.substr(0, 2) == "0X") {
-                std::stringstream ss;
-                ss << std::hex << colorStr.substr(2);
-                ss >> color;
+        if (end - cursor > 3 && cursor[0] == ',' && cursor[1] == '0' && (cursor[2] == 'x' || cursor[2] == 'X')) {
+            long value = LONG_MAX;
+            parsed = std::from_chars(cursor + 3, end, value, 16);
+            if (parsed.ec != std::errc::invalid_argument) {
+                color = static_cast<int>(std::min<long>(value, INT_MAX));
                 hasCustomColor = true;
             }
-        } else {
-            z = std::stoi(token);
         }
-        
-        points.push_back(Map::MapPoint(z, color, hasCustomColor));
-        
-        _minHeight = std::min(_minHeight, z);
-        _maxHeight = std::max(_maxHeight, z);
+        while (cursor < end && !std::isspace(static_cast<unsigned char>(*cursor)))
+            cursor++;
+
+        *points++ = Map::MapPoint(static_cast<int>(z), color, hasCustomColor);
     }
 }
 
 /**
- * @brief Recalculates the minimum and maximum height values in the map.
+ * @brief Calculates the minimum and maximum raw height values in the map.
+ *
+ * Runs once at load time, after rows have been padded. Scaled extrema are
+ * derived from these values and the Z factor, so changing the factor never
+ * requires another scan. No-data cells are skipped so the sentinel does not
+ * stretch the color range.
  */
 void HeightMap::calculateMinMaxHeight() {
     _minHeight = INT_MAX;
     _maxHeight = INT_MIN;
 
+    const std::vector<Map::MapLine> &mapData = _map.getMapData();
     for (int y = 0; y < _matrixHeight; y++) {
         for (int x = 0; x < _matrixWidth; x++) {
-            int z = getZ(x, y);
+            if (isNoData(x, y))
+                continue;
+            int z = mapData[y][x].z;
             if (z < _minHeight)
                 _minHeight = z;
             if (z > _maxHeight)
                 _maxHeight = z;
         }
     }
+
+    if (_minHeight > _maxHeight) {
+        _minHeight = 0;
+        _maxHeight = 0;
+    }
+}
+
+/**
+ * @brief Takes the raw height range from the cached chunk ranges.
+ *
+ * Same result as calculateMinMaxHeight() for up-to-date chunks, at the cost of
+ * one pass over the chunks. Chunks whose owned cells are all no-data are
+ * skipped; their border vertices are owned, and counted, by a neighbor.
+ */
+void HeightMap::calculateMinMaxFromChunks() {
+    _minHeight = INT_MAX;
+    _maxHeight = INT_MIN;
+
+    for (const Chunk &chunk : _chunks) {
+        if (chunk.noDataCount == (chunk.xEnd - chunk.x0) * (chunk.yEnd - chunk.y0))
+            continue;
+        _minHeight = std::min(_minHeight, chunk.minZ);
+        _maxHeight = std::max(_maxHeight, chunk.maxZ);
+    }
+
+    if (_minHeight > _maxHeight) {
+        _minHeight = 0;
+        _maxHeight = 0;
+    }
+}
+
+/**
+ * @brief Flags every cell holding the no-data value, one bit per cell.
+ *
+ * Without a configured no-data value the mask is all clear.
+ */
+void HeightMap::buildNoDataMask() {
+    const std::vector<Map::MapLine> &mapData = _map.getMapData();
+
+    _noDataMask.assign(static_cast<size_t>(_matrixWidth) * _matrixHeight, false);
+    if (!_noDataValue)
+        return;
+
+    for (int y = 0; y < _matrixHeight; y++) {
+        for (int x = 0; x < _matrixWidth; x++) {
+            if (mapData[y][x].z == *_noDataValue)
+                _noDataMask[static_cast<size_t>(y) * _matrixWidth + x] = true;
+        }
+    }
+}
+
+/**
+ * @brief Returns the configured no-data height, if any.
+ */
+std::optional<int> HeightMap::getNoDataValue() const {
+    return _noDataValue;
+}
+
+/**
+ * @brief Partitions the grid into CHUNK_SIZE x CHUNK_SIZE blocks and caches
+ *        the raw height range of each one.
+ *
+ * The range of a chunk also covers its extra right column and bottom row, so
+ * its bounding box encloses every edge the chunk owns.
+ */
+void HeightMap::buildChunks() {
+    _chunks.clear();
+    _chunkColumns = (_matrixWidth + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    _chunkRows = (_matrixHeight + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    for (int y0 = 0; y0 < _matrixHeight; y0 += CHUNK_SIZE) {
+        for (int x0 = 0; x0 < _matrixWidth; x0 += CHUNK_SIZE) {
+            Chunk chunk;
+            chunk.x0 = x0;
+            chunk.y0 = y0;
+            chunk.xEnd = std::min(x0 + CHUNK_SIZE, _matrixWidth);
+            chunk.yEnd = std::min(y0 + CHUNK_SIZE, _matrixHeight);
+            chunk.xMax = std::min(chunk.xEnd, _matrixWidth - 1);
+            chunk.yMax = std::min(chunk.yEnd, _matrixHeight - 1);
+            measureChunk(chunk);
+            _chunks.push_back(chunk);
+        }
+    }
+    buildEdgeList();
+}
+
+/**
+ * @brief Recomputes the height range and no-data count of one chunk.
+ * @param chunk Chunk whose vertex range is already set.
+ */
+void HeightMap::measureChunk(Chunk &chunk) {
+    const std::vector<Map::MapLine> &mapData = _map.getMapData();
+
+    chunk.minZ = INT_MAX;
+    chunk.maxZ = INT_MIN;
+    chunk.noDataCount = 0;
+    for (int y = chunk.y0; y <= chunk.yMax; y++) {
+        for (int x = chunk.x0; x <= chunk.xMax; x++) {
+            if (isNoData(x, y)) {
+                if (x < chunk.xEnd && y < chunk.yEnd)
+                    chunk.noDataCount++;
+                continue;
+            }
+            int z = mapData[y][x].z;
+            chunk.minZ = std::min(chunk.minZ, z);
+            chunk.maxZ = std::max(chunk.maxZ, z);
+        }
+    }
+    if (chunk.minZ > chunk.maxZ) {
+        chunk.minZ = 0;
+        chunk.maxZ = 0;
+    }
+}
+
+/**
+ * @brief Rebuilds the shared edge list chunk by chunk.
+ *
+ * Needed again whenever a cell enters or leaves no-data.
+ */
+void HeightMap::buildEdgeList() {
+    _edges.clear();
+    _edges.reserve(static_cast<size_t>(_matrixWidth) * _matrixHeight * 2);
+    _edgeRows.clear();
+    for (Chunk &chunk : _chunks)
+        buildEdges(chunk);
+}
+
+/**
+ * @brief Appends the edges owned by a chunk to the shared edge list.
+ *
+ * Each owned vertex contributes its right and bottom edges when those neighbors
+ * exist; edges touching a no-data vertex are left out. Edges are emitted row by
+ * row and the start of each row is recorded, so the renderer can walk rows in
+ * either direction.
+ *
+ * @param chunk Chunk whose vertex range is already set.
+ */
+void HeightMap::buildEdges(Chunk &chunk) {
+    int blockWidth = chunk.xMax - chunk.x0 + 1;
+
+    chunk.edgeBegin = _edges.size();
+    chunk.rowBegin = _edgeRows.size();
+    for (int y = chunk.y0; y < chunk.yEnd; y++) {
+        _edgeRows.push_back(_edges.size());
+        for (int x = chunk.x0; x < chunk.xEnd; x++) {
+            if (isNoData(x, y))
+                continue;
+            uint16_t index = (y - chunk.y0) * blockWidth + (x - chunk.x0);
+            if (x + 1 < _matrixWidth && !isNoData(x + 1, y))
+                _edges.push_back({index, static_cast<uint16_t>(index + 1)});
+            if (y + 1 < _matrixHeight && !isNoData(x, y + 1))
+                _edges.push_back({index, static_cast<uint16_t>(index + blockWidth)});
+        }
+    }
+    chunk.edgeEnd = _edges.size();
+    _edgeRows.push_back(chunk.edgeEnd);
+}
+
+/**
+ * @brief Computes the slope of every vertex from its grid neighbors.
+ *
+ * Rows are split into bands computed on the shared worker pool.
+ */
+void HeightMap::buildSlopes() {
+    _slopes.resize(static_cast<size_t>(_matrixWidth) * _matrixHeight);
+
+    int nThreads = std::max(1, std::min(WorkerPool::shared().getThreadCount(), _matrixHeight / 64));
+
+    auto computeBand = [this, nThreads](int band) {
+        int rowEnd = static_cast<long>(_matrixHeight) * (band + 1) / nThreads;
+        for (int y = static_cast<long>(_matrixHeight) * band / nThreads; y < rowEnd; y++) {
+            Slope *slope = &_slopes[static_cast<size_t>(y) * _matrixWidth];
+            for (int x = 0; x < _matrixWidth; x++)
+                slope[x] = computeSlope(x, y);
+        }
+    };
+
+    WorkerPool::shared().run(nThreads, computeBand);
+}
+
+/**
+ * @brief Slope of one vertex: central differences, one-sided at the border and
+ *        next to no-data cells, zero on no-data cells.
+ */
+HeightMap::Slope HeightMap::computeSlope(int x, int y) const {
+    if (isNoData(x, y))
+        return {0.0f, 0.0f};
+
+    int up = y > 0 ? y - 1 : y;
+    int down = y + 1 < _matrixHeight ? y + 1 : y;
+    int left = x > 0 && !isNoData(x - 1, y) ? x - 1 : x;
+    int right = x + 1 < _matrixWidth && !isNoData(x + 1, y) ? x + 1 : x;
+    int top = isNoData(x, up) ? y : up;
+    int bottom = isNoData(x, down) ? y : down;
+
+    Slope slope;
+    slope.dx = right > left ? static_cast<float>(_matrix[y][right] - _matrix[y][left]) / (right - left) : 0.0f;
+    slope.dy = bottom > top ? static_cast<float>(_matrix[bottom][x] - _matrix[top][x]) / (bottom - top) : 0.0f;
+    return slope;
+}
+
+/**
+ * @brief Histogram bin of a raw height inside [_minHeight, _maxHeight].
+ */
+int HeightMap::histogramBin(int z) const {
+    return static_cast<int>((static_cast<long>(z) - _minHeight) / _binWidth);
+}
+
+/**
+ * @brief Builds the histogram-equalization table used by equalizeHeight().
+ *
+ * Heights are binned over the raw range, at most HISTOGRAM_BINS bins wide, and
+ * each bin is mapped to the fraction of vertices below its middle, so palette
+ * positions follow how often heights occur rather than their extremes. Rows are
+ * counted in bands on the worker pool, each into its own histogram, and the
+ * histograms are summed. No-data cells are not counted. Heights are kept raw, so
+ * the table does not depend on the Z factor. The tables keep their capacity and
+ * grow to twice the bins needed, so sculpting that widens the range does not
+ * reallocate them on every stroke.
+ */
+void HeightMap::buildHistogram() {
+    long range = static_cast<long>(_maxHeight) - _minHeight + 1;
+    int bins = static_cast<int>(std::min<long>(range, HISTOGRAM_BINS));
+    _binWidth = (range + bins - 1) / bins;
+
+    int nThreads = std::max(1, std::min(WorkerPool::shared().getThreadCount(), _matrixHeight / 64));
+
+    if (_histogram.capacity() < static_cast<size_t>(bins)) {
+        size_t reserved = std::min<size_t>(static_cast<size_t>(bins) * 2, HISTOGRAM_BINS);
+        _histogram.reserve(reserved);
+        _equalized.reserve(reserved);
+        _bandHistograms.reserve(static_cast<size_t>(nThreads - 1) * reserved);
+    }
+    _histogram.assign(bins, 0);
+    _bandHistograms.assign(static_cast<size_t>(nThreads - 1) * bins, 0);
+    auto countBand = [&](int band) {
+        int *histogram = band == 0 ? _histogram.data() : &_bandHistograms[static_cast<size_t>(band - 1) * bins];
+        int rowEnd = static_cast<long>(_matrixHeight) * (band + 1) / nThreads;
+        for (int y = static_cast<long>(_matrixHeight) * band / nThreads; y < rowEnd; y++) {
+            for (int x = 0; x < _matrixWidth; x++) {
+                if (!isNoData(x, y))
+                    histogram[histogramBin(_matrix[y][x])]++;
+            }
+        }
+    };
+
+    WorkerPool::shared().run(nThreads, countBand);
+
+    for (size_t i = 0; i < _bandHistograms.size(); i++)
+        _histogram[i % bins] += _bandHistograms[i];
+    buildEqualization();
+}
+
+/**
+ * @brief Maps each histogram bin to the fraction of vertices below its middle.
+ */
+void HeightMap::buildEqualization() {
+    long total = 0;
+    for (int count : _histogram)
+        total += count;
+
+    _equalized.resize(_histogram.size());
+    long below = 0;
+    for (size_t bin = 0; bin < _histogram.size(); bin++) {
+        int count = _histogram[bin];
+        _equalized[bin] = total > 0 ? (below + count / 2.0f) / total : 0.5f;
+        below += count;
+    }
+}
+
+/**
+ * @brief Returns the grid chunks with their cached height ranges.
+ */
+const std::vector<HeightMap::Chunk> &HeightMap::getChunks() const {
+    return _chunks;
+}
+
+/**
+ * @brief Returns the static edge list, grouped by chunk.
+ */
+const std::vector<HeightMap::Edge> &HeightMap::getEdges() const {
+    return _edges;
+}
+
+/**
+ * @brief Returns the per-row offsets into the edge list; see Chunk::rowBegin.
+ */
+const std::vector<int> &HeightMap::getEdgeRows() const {
+    return _edgeRows;
+}
+
+int HeightMap::getChunkColumns() const {
+    return _chunkColumns;
+}
+
+int HeightMap::getChunkRows() const {
+    return _chunkRows;
 }
 
 /**
@@ -139,10 +616,13 @@ int HeightMap::getMatrixHeight() const {
 }
 
 /**
- * @brief Gets the Z value at (x, y), applying Z scaling.
+ * @brief Gets the raw Z value at (x, y).
+ *
+ * The Z factor is not applied here; the camera scales heights when
+ * transforming points to screen space.
  */
 int HeightMap::getZ(int x, int y) const {
-    return _map.getZ(x, y) * _zFactor;
+    return _map.getZ(x, y);
 }
 
 /**
@@ -160,7 +640,21 @@ bool HeightMap::hasCustomColor(int x, int y) const {
 }
 
 /**
- * @brief Normalizes a Z value between 0.0 and 1.0 based on height range.
+ * @brief Returns the lowest raw height in the map.
+ */
+int HeightMap::getMinHeight() const {
+    return _minHeight;
+}
+
+/**
+ * @brief Returns the highest raw height in the map.
+ */
+int HeightMap::getMaxHeight() const {
+    return _maxHeight;
+}
+
+/**
+ * @brief Normalizes a raw Z value between 0.0 and 1.0 based on the raw height range.
  */
 float HeightMap::normalizeHeight(int z) const {
     if (_maxHeight == _minHeight) {
@@ -169,9 +663,23 @@ float HeightMap::normalizeHeight(int z) const {
     return static_cast<float>(z - _minHeight) / (_maxHeight - _minHeight);
 }
 
+/**
+ * @brief Maps a raw Z value to its histogram-equalized position between 0.0 and 1.0.
+ *
+ * A table lookup, so a tall outlier only claims the palette share its vertex
+ * count deserves. Values outside the raw range clamp to the end bins.
+ */
+float HeightMap::equalizeHeight(int z) const {
+    long bin = (static_cast<long>(z) - _minHeight) / _binWidth;
+    bin = std::max(0L, std::min(bin, static_cast<long>(_equalized.size()) - 1));
+    return _equalized[bin];
+}
+
 /**
  * @brief Sets the Z scaling factor.
  *
+ * Only the factor is stored; heights and their range stay raw, so this is O(1).
+ *
  * @param factor Amount to add or subtract.
  * @param mode Whether to increase (+1) or decrease (-1).
  */
@@ -180,8 +688,6 @@ void HeightMap::setZFactor(double factor, int mode) {
         _zFactor += factor;
     if (mode < 0)
         _zFactor -= factor;
-        
-    calculateMinMaxHeight();
 }
 
 /**
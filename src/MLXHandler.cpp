@@ -8,6 +8,14 @@
  */
 #include "../includes/MLXHandler.hpp"
 #include "../includes/FDF.hpp"
+#include "../includes/UI.hpp"
+#include "../includes/Benchmark.hpp"
+#include "../includes/mapHandler/MapLoader.hpp"
+#include "../includes/mapHandler/HeightStream.hpp"
+#include "../includes/mapHandler/FrameSequence.hpp"
+#include "../includes/mapHandler/MapParser.hpp"
+#include <cstdio>
+#include <iostream>
 
 /**
  * @brief Constructs an MLXHandler object and initializes the MLX42 window and image buffers.
@@ -20,7 +28,8 @@
  * @param title Title of the window.
  */
 MLXHandler::MLXHandler(int width, int height, const char *title)
-    : _width(width), _height(height), _title(title), _autoRotate(false),
+    : _width(width), _height(height), _title(title), _fdf(NULL), _overlay(NULL), _loader(NULL), _stream(NULL), _sequence(NULL), _benchmark(NULL),
+      _previewRows(0), _autoRotate(false), _sculptStale(false),
       _leftMousePressed(false), _rightMousePressed(false), _lastMouseX(0), _lastMouseY(0) {
     this->_mlx = mlx_init(this->_width, this->_height, this->_title, true);
 
@@ -118,20 +127,222 @@ void MLXHandler::setFDF(FDF *fdf){
     _fdf = fdf;
 }
 
+/**
+ * @brief Sets the UI overlay whose map info is refreshed when the FDF is replaced.
+ */
+void MLXHandler::setOverlay(UI *overlay){
+    _overlay = overlay;
+}
+
+/**
+ * @brief Sets the loader still reading the map shown as a preview.
+ *
+ * While set, loadHook() replaces the current height map with finer previews as rows
+ * arrive and with the full map once the file is read. Must be called before
+ * handleEvents().
+ *
+ * @param loader Background loader, or NULL once the map is complete.
+ */
+void MLXHandler::setLoader(MapLoader *loader){
+    _loader = loader;
+    _previewRows = loader ? loader->getRowCount() : 0;
+}
+
 void MLXHandler::render() const{
     mlx_loop(this->_mlx);
 }
 
+/**
+ * @brief Sets the live height stream feeding the current FDF.
+ *
+ * Must be called before handleEvents().
+ *
+ * @param stream Stream whose grid size matches the FDF's height map, or NULL.
+ */
+void MLXHandler::setStream(HeightStream *stream){
+    _stream = stream;
+}
+
+/**
+ * @brief Sets the frame sequence played on the current FDF.
+ *
+ * Must be called before handleEvents().
+ *
+ * @param sequence Sequence whose grid size matches the FDF's height map, or NULL.
+ */
+void MLXHandler::setSequence(FrameSequence *sequence){
+    _sequence = sequence;
+}
+
+/**
+ * @brief Runs a benchmark over the next frames, auto-rotating the map so each one is fully redrawn.
+ *
+ * The window closes once the benchmark is done. Must be called before handleEvents().
+ *
+ * @param benchmark Benchmark to feed, or NULL.
+ */
+void MLXHandler::setBenchmark(Benchmark *benchmark){
+    _benchmark = benchmark;
+    if (_benchmark)
+        _autoRotate = true;
+}
+
 /**
  * @brief Registers event hooks for MLX42 input and window events.
  *
  * Sets up hooks for main loop, scroll, perspective changes, and mouse input.
+ * Benchmark hooks, when a benchmark is set, run first and last in each frame.
  */
 void MLXHandler::handleEvents(){
+    if (_benchmark)
+        mlx_loop_hook(_mlx, frameStartHook, this);
+    if (_loader)
+        mlx_loop_hook(_mlx, loadHook, this);
+    if (_stream)
+        mlx_loop_hook(_mlx, streamHook, this);
+    if (_sequence)
+        mlx_loop_hook(_mlx, playHook, this);
     mlx_loop_hook(_mlx, basicHooks, this);
     mlx_scroll_hook(_mlx, &scrollHook, this);
     mlx_loop_hook(_mlx, perspectiveHooks, this);
     mlx_mouse_hook(_mlx, &mouseHook, this);
+    if (_benchmark)
+        mlx_loop_hook(_mlx, frameEndHook, this);
+}
+
+/**
+ * @brief First loop hook of a benchmarked frame.
+ *
+ * @param param Pointer to the MLXHandler instance.
+ */
+void MLXHandler::frameStartHook(void *param) {
+    static_cast<MLXHandler *>(param)->_benchmark->beginFrame();
+}
+
+/**
+ * @brief Last loop hook of a benchmarked frame; closes the window once the benchmark is done.
+ *
+ * @param param Pointer to the MLXHandler instance.
+ */
+void MLXHandler::frameEndHook(void *param) {
+    MLXHandler *self = static_cast<MLXHandler *>(param);
+    self->_benchmark->endFrame();
+    if (self->_benchmark->isDone())
+        mlx_close_window(self->_mlx);
+}
+
+/**
+ * @brief Loop hook refining a progressively loaded map.
+ *
+ * Whenever the rows read have doubled since the last preview, or the loader is
+ * done, the next height map is built on a worker thread while the current one
+ * stays interactive, and swapped into the FDF on the first frame after it is
+ * ready, so the view and every display setting carry over. The worker only
+ * touches the loader and its own height map, never the projector or camera the
+ * main thread keeps changing. The full map is validated like a map given
+ * upfront; a malformed file closes the window.
+ *
+ * @param param Pointer to the MLXHandler instance.
+ */
+void MLXHandler::loadHook(void *param) {
+    MLXHandler *self = static_cast<MLXHandler *>(param);
+    MapLoader *loader = self->_loader;
+    if (!loader)
+        return;
+
+    if (self->_nextHeightMap.valid()) {
+        if (self->_nextHeightMap.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+
+        HeightMap *next;
+        try {
+            next = self->_nextHeightMap.get();
+        } catch (const std::exception &e) {
+            std::cout << "Exception caught: " << e.what() << std::endl;
+            self->_loader = NULL;
+            mlx_close_window(self->_mlx);
+            return;
+        }
+        if (self->_nextIsFinal)
+            self->_loader = NULL;
+
+        self->_fdf->setHeightMap(std::move(*next));
+        delete next;
+        if (self->_overlay)
+            self->_overlay->setHeightMap(self->_fdf->getHeightMap());
+        self->clearImage(self->_img);
+        self->_fdf->draw();
+        return;
+    }
+
+    bool done = loader->isDone();
+    size_t rows = loader->getRowCount();
+    if (!done && rows < 2 * self->_previewRows)
+        return;
+
+    std::optional<int> noDataValue = self->_fdf->getHeightMap()->getNoDataValue();
+    self->_previewRows = rows;
+    self->_nextIsFinal = done;
+    self->_nextHeightMap = std::async(std::launch::async, [=]() {
+        LoadArena text;
+        std::vector<std::string_view> map = done ? loader->takeRows(text) : loader->getPreview(text);
+        HeightMap *next = new HeightMap(map, noDataValue, &text);
+        if (done) {
+            try {
+                MapParser parser(next->getMatrix());
+                parser.parseMap();
+            } catch (...) {
+                delete next;
+                throw;
+            }
+        }
+        return next;
+    });
+}
+
+/**
+ * @brief Loop hook applying the latest frame of a live height stream.
+ *
+ * Frames that arrived while the previous one was being drawn are skipped, so
+ * the display always shows the newest heights without falling behind. Only the
+ * rectangle the skipped and new frames changed is copied into the map.
+ *
+ * @param param Pointer to the MLXHandler instance.
+ */
+void MLXHandler::streamHook(void *param) {
+    MLXHandler *self = static_cast<MLXHandler *>(param);
+    HeightStream::Region region;
+    const std::vector<int> *frame = self->_stream->acquireFrame(region);
+    if (!frame)
+        return;
+
+    size_t width = self->_stream->getWidth();
+    self->_fdf->updateRegion(region.x0, region.y0, region.x1 - region.x0, region.y1 - region.y0,
+                             frame->data() + region.y0 * width + region.x0, width);
+    self->clearImage(self->_img);
+    self->_fdf->draw();
+}
+
+/**
+ * @brief Loop hook showing the next frame of a sequence once it is due.
+ *
+ * Only the rectangle that differs from the previous frame is copied into the
+ * map; frames equal to the previous one are not redrawn.
+ *
+ * @param param Pointer to the MLXHandler instance.
+ */
+void MLXHandler::playHook(void *param) {
+    MLXHandler *self = static_cast<MLXHandler *>(param);
+    FrameSequence::Region region;
+    const std::vector<int> *frame = self->_sequence->acquireFrame(region);
+    if (!frame || region.x0 >= region.x1)
+        return;
+
+    size_t width = self->_sequence->getWidth();
+    self->_fdf->updateRegion(region.x0, region.y0, region.x1 - region.x0, region.y1 - region.y0,
+                             frame->data() + region.y0 * width + region.x0, width);
+    self->clearImage(self->_img);
+    self->_fdf->draw();
 }
 
 /**
@@ -149,6 +360,13 @@ void MLXHandler::clearImage(mlx_image_t *img){
 }
 
 void MLXHandler::cleanup() {
+    if (this->_nextHeightMap.valid()) {
+        try {
+            delete this->_nextHeightMap.get();
+        } catch (const std::exception &) {
+        }
+    }
+
     if (this->_img && this->_mlx) {
         mlx_delete_image(this->_mlx, this->_img);
         this->_img = nullptr;
@@ -164,6 +382,9 @@ void MLXHandler::cleanup() {
  * @brief Mouse event hook for MLX42. Handles mouse button presses and releases.
  *
  * Tracks left and right mouse button states and updates last mouse position.
+ * Releasing the left button ends a sculpting drag, and redraws the frame if the
+ * strokes left colors outside their area outdated. While inspecting with the
+ * brush off, a left click also prints the vertex under the cursor.
  *
  * @param button Mouse button pressed or released.
  * @param action MLX_PRESS or MLX_RELEASE.
@@ -182,8 +403,15 @@ void MLXHandler::mouseHook(mouse_key_t button, action_t action, modifier_key_t m
             self->_leftMousePressed = true;
             self->_lastMouseX = mouseX;
             self->_lastMouseY = mouseY;
+            if (self->_fdf->getRenderer()->getInspectStatus() && self->_brush.getMode() == Brush::OFF)
+                self->inspect(mouseX, mouseY, true);
         } else if (action == MLX_RELEASE) {
             self->_leftMousePressed = false;
+            if (self->_sculptStale) {
+                self->_sculptStale = false;
+                self->clearImage(self->_img);
+                self->_fdf->draw();
+            }
         }
     } else if (button == MLX_MOUSE_BUTTON_RIGHT) {
         if (action == MLX_PRESS) {
@@ -200,7 +428,7 @@ void MLXHandler::mouseHook(mouse_key_t button, action_t action, modifier_key_t m
  * @brief Main loop hook for MLX42. Handles keyboard and mouse input for camera, VFX, and color changes.
  *
  * Processes input events for panning, zooming, rotating, effect toggles, color set changes, and auto-rotation.
- * Redraws the scene as needed.
+ * Redraws the scene as needed; frames that only pan are scrolled instead of redrawn.
  *
  * @param param Pointer to MLXHandler instance.
  */
@@ -214,6 +442,16 @@ void MLXHandler::basicHooks(void *param) {
     static bool fourKeyWasPressed = false;
     static bool fiveKeyWasPressed = false;
     static bool sixKeyWasPressed = false;
+    static bool hKeyWasPressed = false;
+    static bool fKeyWasPressed = false;
+    static bool nKeyWasPressed = false;
+    static bool cKeyWasPressed = false;
+    static bool bKeyWasPressed = false;
+    static bool zKeyWasPressed = false;
+    static bool xKeyWasPressed = false;
+    static bool vKeyWasPressed = false;
+    static bool leftBracketKeyWasPressed = false;
+    static bool rightBracketKeyWasPressed = false;
 
     static bool PadOneKeyWasPressed = false;
     static bool PadTwoKeyWasPressed = false;
@@ -221,8 +459,11 @@ void MLXHandler::basicHooks(void *param) {
     static bool PadFourKeyWasPressed = false;
     static bool PadFiveKeyWasPressed = false;
     static bool PadSixKeyWasPressed = false;
+    static bool PadZeroKeyWasPressed = false;
 
     bool needsRedraw = false;
+    int panX = 0;
+    int panY = 0;
 
     if (self->_leftMousePressed || self->_rightMousePressed) {
         int32_t mouseX, mouseY;
@@ -230,10 +471,14 @@ void MLXHandler::basicHooks(void *param) {
         
         int deltaX = mouseX - self->_lastMouseX;
         int deltaY = mouseY - self->_lastMouseY;
-        
-        if (self->_leftMousePressed && (deltaX != 0 || deltaY != 0)) {
-            self->_fdf->pan(-deltaX, -deltaY);
-            needsRedraw = true;
+        bool sculpting = self->_leftMousePressed && self->_brush.getMode() != Brush::OFF;
+
+        if (sculpting && self->_fdf->sculpt(self->_brush, mouseX, mouseY))
+            self->_sculptStale = true;
+
+        if (self->_leftMousePressed && !sculpting && (deltaX != 0 || deltaY != 0)) {
+            panX -= deltaX;
+            panY -= deltaY;
         }
         
         if (self->_rightMousePressed && (deltaX != 0 || deltaY != 0)) {
@@ -258,6 +503,24 @@ void MLXHandler::basicHooks(void *param) {
         needsRedraw = true;
     }
 
+    bool nKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_N);
+    if (nKeyIsPressed && !nKeyWasPressed) {
+        self->_fdf->getColorManager()->setLightingStatus(!self->_fdf->getColorManager()->getLightingStatus());
+        needsRedraw = true;
+    }
+    nKeyWasPressed = nKeyIsPressed;
+
+    if (self->_fdf->getColorManager()->getLightingStatus()) {
+        if (mlx_is_key_down(self->_mlx, MLX_KEY_COMMA)) {
+            self->_fdf->getColorManager()->rotateLight(-0.05);
+            needsRedraw = true;
+        }
+        if (mlx_is_key_down(self->_mlx, MLX_KEY_PERIOD)) {
+            self->_fdf->getColorManager()->rotateLight(0.05);
+            needsRedraw = true;
+        }
+    }
+
     if (mlx_is_key_down(self->_mlx, MLX_KEY_KP_SUBTRACT)) {
         self->_fdf->zoom(0.9, -1, -1);
         needsRedraw = true;
@@ -267,22 +530,16 @@ void MLXHandler::basicHooks(void *param) {
         needsRedraw = true;
     }
 
-    if (mlx_is_key_down(self->_mlx, MLX_KEY_A)) {
-        self->_fdf->pan(10, 0);
-        needsRedraw = true;
-    }
-    if (mlx_is_key_down(self->_mlx, MLX_KEY_D)) {
-        self->_fdf->pan(-10, 0);
-        needsRedraw = true;
-    }
-    if (mlx_is_key_down(self->_mlx, MLX_KEY_W)) {
-        self->_fdf->pan(0, 10);
-        needsRedraw = true;
-    }
-    if (mlx_is_key_down(self->_mlx, MLX_KEY_S)) {
-        self->_fdf->pan(0, -10);
-        needsRedraw = true;
-    }
+    if (mlx_is_key_down(self->_mlx, MLX_KEY_A))
+        panX += 10;
+    if (mlx_is_key_down(self->_mlx, MLX_KEY_D))
+        panX -= 10;
+    if (mlx_is_key_down(self->_mlx, MLX_KEY_W))
+        panY += 10;
+    if (mlx_is_key_down(self->_mlx, MLX_KEY_S))
+        panY -= 10;
+    if (panX != 0 || panY != 0)
+        self->_fdf->pan(panX, panY);
 
     if (mlx_is_key_down(self->_mlx, MLX_KEY_Q)) {
         self->_fdf->rotateZ(-0.05);
@@ -365,6 +622,13 @@ void MLXHandler::basicHooks(void *param) {
     }
     PadSixKeyWasPressed = PadSixKeyIsPressed;
 
+    bool PadZeroKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_KP_0);
+    if (PadZeroKeyIsPressed && !PadZeroKeyWasPressed) {
+        self->_fdf->getColorManager()->setEqualizedStatus(!self->_fdf->getColorManager()->getEqualizedStatus());
+        needsRedraw = true;
+    }
+    PadZeroKeyWasPressed = PadZeroKeyIsPressed;
+
     bool oneKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_1);
     if (oneKeyIsPressed && !oneKeyWasPressed) {
         self->setAutoRotate(!self->getAutoRotate());
@@ -407,19 +671,118 @@ void MLXHandler::basicHooks(void *param) {
     }
     sixKeyWasPressed = sixKeyIsPressed;
 
+    bool hKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_H);
+    if (hKeyIsPressed && !hKeyWasPressed) {
+        self->_fdf->getRenderer()->setDepthTestStatus(!self->_fdf->getRenderer()->getDepthTestStatus());
+        needsRedraw = true;
+    }
+    hKeyWasPressed = hKeyIsPressed;
+
+    bool fKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_F);
+    if (fKeyIsPressed && !fKeyWasPressed) {
+        self->_fdf->getRenderer()->setFillStatus(!self->_fdf->getRenderer()->getFillStatus());
+        needsRedraw = true;
+    }
+    fKeyWasPressed = fKeyIsPressed;
+
+    bool cKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_C);
+    if (cKeyIsPressed && !cKeyWasPressed) {
+        self->_fdf->getRenderer()->setContourStatus(!self->_fdf->getRenderer()->getContourStatus());
+        needsRedraw = true;
+    }
+    cKeyWasPressed = cKeyIsPressed;
+
+    bool bKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_B);
+    bool zKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_Z);
+    bool xKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_X);
+    if ((bKeyIsPressed && !bKeyWasPressed) || (zKeyIsPressed && !zKeyWasPressed) || (xKeyIsPressed && !xKeyWasPressed)) {
+        if (bKeyIsPressed && !bKeyWasPressed) {
+            self->_brush.cycleMode();
+            self->_fdf->getRenderer()->setSculptStatus(self->_brush.getMode() != Brush::OFF);
+            needsRedraw = true;
+        }
+        if (zKeyIsPressed && !zKeyWasPressed)
+            self->_brush.setRadius(self->_brush.getRadius() / 2);
+        if (xKeyIsPressed && !xKeyWasPressed)
+            self->_brush.setRadius(self->_brush.getRadius() * 2);
+        if (self->_overlay)
+            self->_overlay->setBrushStatus(self->_brush.getModeName(), self->_brush.getRadius());
+    }
+    bKeyWasPressed = bKeyIsPressed;
+    zKeyWasPressed = zKeyIsPressed;
+    xKeyWasPressed = xKeyIsPressed;
+
+    bool vKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_V);
+    if (vKeyIsPressed && !vKeyWasPressed) {
+        Renderer *renderer = self->_fdf->getRenderer();
+        renderer->setInspectStatus(!renderer->getInspectStatus());
+        if (!renderer->getInspectStatus() && self->_overlay)
+            self->_overlay->clearInspection();
+        needsRedraw = true;
+    }
+    vKeyWasPressed = vKeyIsPressed;
+
+    Contours *contours = self->_fdf->getContours();
+    bool leftBracketKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_LEFT_BRACKET);
+    if (leftBracketKeyIsPressed && !leftBracketKeyWasPressed && self->_fdf->getRenderer()->getContourStatus()) {
+        contours->setInterval(contours->getInterval() / 2);
+        needsRedraw = true;
+    }
+    leftBracketKeyWasPressed = leftBracketKeyIsPressed;
+
+    bool rightBracketKeyIsPressed = mlx_is_key_down(self->_mlx, MLX_KEY_RIGHT_BRACKET);
+    if (rightBracketKeyIsPressed && !rightBracketKeyWasPressed && self->_fdf->getRenderer()->getContourStatus()) {
+        contours->setInterval(contours->getInterval() * 2);
+        needsRedraw = true;
+    }
+    rightBracketKeyWasPressed = rightBracketKeyIsPressed;
+
     if (self->getAutoRotate()) {
         self->_fdf->rotateZ(0.02f);
         needsRedraw = true;
     }
 
-     if (needsRedraw || (self->_fdf->getVFX()->getJitterIntensity() > 0 && frameCount % 2 == 0)) {
+    if (needsRedraw || (self->_fdf->getVFX()->isActive() && frameCount % 2 == 0)) {
         self->clearImage(self->_img);
         self->_fdf->draw();
+    } else if (panX != 0 || panY != 0) {
+        self->_fdf->drawPanned(panX, panY);
+    }
+
+    if (self->_fdf->getRenderer()->getInspectStatus()) {
+        int32_t mouseX, mouseY;
+        mlx_get_mouse_pos(self->_mlx, &mouseX, &mouseY);
+        self->inspect(mouseX, mouseY, false);
     }
 
     frameCount++;
 }
 
+/**
+ * @brief Shows the grid vertex under the cursor in the UI panel.
+ *
+ * Heights are read again every frame, so the panel follows sculpting and live
+ * streams under a still cursor.
+ *
+ * @param mouseX Cursor column.
+ * @param mouseY Cursor row.
+ * @param print Also print "x y z #RRGGBB" to stdout.
+ */
+void MLXHandler::inspect(int32_t mouseX, int32_t mouseY, bool print) {
+    int x, y;
+    if (!_overlay || !_fdf->getRenderer()->pickVertex(mouseX, mouseY, x, y))
+        return;
+
+    int z = _fdf->getHeightMap()->getZ(x, y);
+    uint32_t color = _fdf->getColorManager()->getColorFromHeight(x, y, z);
+    _overlay->setInspection(x, y, z, color);
+    if (print) {
+        char hex[8];
+        snprintf(hex, sizeof(hex), "%06X", color >> 8);
+        std::cout << x << " " << y << " " << z << " #" << hex << std::endl;
+    }
+}
+
 /**
  * @brief Scroll event hook for MLX42. Handles mouse wheel zooming.
  *
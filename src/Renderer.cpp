@@ -9,23 +9,30 @@
 #include "../includes/Renderer.hpp"
 #include "../includes/FDF.hpp"
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 /**
  * @brief Constructs a Renderer object for drawing the heightmap and wireframe.
  *
- * Initializes references to MLXHandler, HeightMap, Camera, ColorManager, and VFX.
+ * Initializes references to MLXHandler, HeightMap, Camera, ColorManager, Contours and VFX.
  * Sets up the rendering state and time variable for effects.
  *
  * @param MLXHandler Reference to the MLX rendering context.
  * @param heightMap Reference to the HeightMap to render.
  * @param camera Reference to the Camera for coordinate transformations.
  * @param colorManager Reference to the ColorManager for color interpolation.
+ * @param contours Reference to the contour cache drawn by the isoline overlay.
  * @param vfx Pointer to the VFX engine for visual effects.
  */
 Renderer::Renderer(MLXHandler &MLXHandler, HeightMap &heightMap, Camera &camera, 
-                   ColorManager &colorManager, VFX *vfx)
+                   ColorManager &colorManager, Contours &contours, VFX *vfx)
     : _MLXHandler(MLXHandler), _heightMap(heightMap), _camera(camera), 
-      _colorManager(colorManager), _vfx(vfx), _time(0.0f) {
+      _colorManager(colorManager), _contours(contours), _vfx(vfx), _time(0.0f),
+      _depthTest(false), _fillStatus(false), _contourStatus(false), _tiledMap(NULL), _overviewLevel(0),
+      _inspectStatus(false), _sculptStatus(false), _pickStatus(false), _pickIndexValid(false), _pickColumns(0) {
+    _clip = {0, 0, _MLXHandler.getWidth(), _MLXHandler.getHeight()};
+    _vertices.resize((HeightMap::CHUNK_SIZE + 1) * (HeightMap::CHUNK_SIZE + 1));
 }
 
 /**
@@ -36,66 +43,692 @@ Renderer::~Renderer() {
 
 void Renderer::draw() {
     _time += 0.1f;
-    drawPoints();
-    drawLines();
+    _clip = {0, 0, _MLXHandler.getWidth(), _MLXHandler.getHeight()};
+    if (_depthTest)
+        clearDepth(_clip);
+    if (_pickStatus)
+        clearPickIndex(_clip);
+    drawMap();
+    _pickIndexValid = _pickStatus;
 }
 
 /**
- * @brief Draws all map points to the screen, applying VFX transformations and color interpolation.
+ * @brief Turns hidden-line removal on or off.
+ *
+ * When on, every drawn pixel is tested against a per-pixel depth buffer, so
+ * crossing edges resolve front to back regardless of drawing order.
  *
- * Iterates over the heightmap grid, transforms each point, applies effects, and draws colored pixels.
+ * @param status True to enable the depth test.
  */
-void Renderer::drawPoints() {
-    int pointSize = 0;
-    
-    for (int y = 0; y < _heightMap.getMatrixHeight(); y++) {
-        for (int x = 0; x < _heightMap.getMatrixWidth(); x++) {
-            int z = _heightMap.getZ(x, y);
-            
-            std::pair<int, int> screenPoint = _camera.worldToScreen(x, y, z);
-            
-            int finalX = screenPoint.first;
-            int finalY = screenPoint.second;
-            
-            if (_vfx->getJitterStatus()) {
-                auto jitteredPoint = _vfx->jitter(screenPoint);
-                finalX = jitteredPoint.first;
-                finalY = jitteredPoint.second;
-            }
+void Renderer::setDepthTestStatus(bool status) {
+    _depthTest = status;
+    if (_depthTest)
+        _depthBuffer.resize(static_cast<size_t>(_MLXHandler.getWidth()) * _MLXHandler.getHeight());
+}
+
+bool Renderer::getDepthTestStatus() const {
+    return _depthTest;
+}
+
+/**
+ * @brief Switches between the wireframe and the filled-surface mode.
+ *
+ * @param status True to fill grid cells instead of drawing points and edges.
+ */
+void Renderer::setFillStatus(bool status) {
+    _fillStatus = status;
+}
+
+bool Renderer::getFillStatus() const {
+    return _fillStatus;
+}
+
+/**
+ * @brief Shows or hides the contour line overlay.
+ *
+ * @param status True to draw the isolines cached by Contours over the map.
+ */
+void Renderer::setContourStatus(bool status) {
+    _contourStatus = status;
+}
+
+bool Renderer::getContourStatus() const {
+    return _contourStatus;
+}
+
+/**
+ * @brief Attaches the tiled map the resident height map is an overview of.
+ *
+ * Chunks whose cells grow past DETAIL_CELL_PIXELS on screen are then drawn from
+ * finer tiles instead; see drawDetail().
+ *
+ * @param tiledMap Tiled source, or NULL to draw the height map alone.
+ * @param overviewLevel Level of the tiled map the height map was read from.
+ */
+void Renderer::setTiledMap(TiledMap *tiledMap, int overviewLevel) {
+    _tiledMap = tiledMap;
+    _overviewLevel = tiledMap ? overviewLevel : 0;
+    if (tiledMap)
+        _tileVertices.resize((tiledMap->getTileSize() + 1) * (tiledMap->getTileSize() + 1));
+}
+
+TiledMap *Renderer::getTiledMap() const {
+    return _tiledMap;
+}
+
+/**
+ * @brief Turns vertex inspection on or off; see updatePickStatus().
+ *
+ * @param status True while the vertex under the cursor is inspected.
+ */
+void Renderer::setInspectStatus(bool status) {
+    _inspectStatus = status;
+    updatePickStatus();
+}
+
+bool Renderer::getInspectStatus() const {
+    return _inspectStatus;
+}
+
+/**
+ * @brief Tells the renderer whether a sculpting brush is armed; see updatePickStatus().
+ *
+ * @param status True while brush strokes may pick vertices.
+ */
+void Renderer::setSculptStatus(bool status) {
+    _sculptStatus = status;
+    updatePickStatus();
+}
+
+/**
+ * @brief Maintains the screen-space pick index while inspecting or sculpting.
+ *
+ * While on, every vertex projected for drawing is also recorded in a grid of
+ * PICK_CELL x PICK_CELL pixel cells, each keeping the front-most vertex drawn
+ * inside it, so pickVertex() answers from the last frame without projecting
+ * anything. The index is filled from the next full frame on.
+ */
+void Renderer::updatePickStatus() {
+    bool status = _inspectStatus || _sculptStatus;
+    if (status == _pickStatus)
+        return;
+
+    _pickStatus = status;
+    _pickIndexValid = false;
+    if (_pickStatus) {
+        _pickColumns = (_MLXHandler.getWidth() + PICK_CELL - 1) / PICK_CELL;
+        _pickIndex.resize(static_cast<size_t>(_pickColumns) * ((_MLXHandler.getHeight() + PICK_CELL - 1) / PICK_CELL));
+    }
+}
+
+/**
+ * @brief Picks the tiled-map level a chunk should be drawn at.
+ *
+ * Measures how large one overview cell along the chunk's sides appears on
+ * screen and halves it per finer level until it fits DETAIL_CELL_PIXELS.
+ *
+ * @param chunk Chunk of the overview height map.
+ * @return The overview level, or a finer one.
+ */
+int Renderer::detailLevel(const HeightMap::Chunk &chunk) const {
+    if (!_tiledMap)
+        return _overviewLevel;
+
+    std::pair<int, int> origin = _camera.worldToScreen(chunk.x0, chunk.y0, chunk.minZ);
+    std::pair<int, int> alongX = _camera.worldToScreen(chunk.xMax, chunk.y0, chunk.minZ);
+    std::pair<int, int> alongY = _camera.worldToScreen(chunk.x0, chunk.yMax, chunk.minZ);
+    double cell = std::max(std::hypot(alongX.first - origin.first, alongX.second - origin.second) /
+                               std::max(1, chunk.xMax - chunk.x0),
+                           std::hypot(alongY.first - origin.first, alongY.second - origin.second) /
+                               std::max(1, chunk.yMax - chunk.y0));
+
+    int level = _overviewLevel;
+    while (level > 0 && cell > DETAIL_CELL_PIXELS) {
+        cell /= 2;
+        level--;
+    }
+    return level;
+}
+
+/**
+ * @brief Draws the area of an overview chunk from the tiles of a finer level.
+ *
+ * Walks the level's tiles under the chunk in traversal order, skips those whose
+ * bounding box is off-screen and pages the others in through the tile cache.
+ * Each tile is projected into its own vertex cache, then the edges (or, in fill
+ * mode, the cells) starting on the vertices the chunk owns are drawn, so
+ * neighboring chunks never draw the same edge. Fine vertices sit at fractional
+ * overview coordinates and take the colors of their nearest overview vertex.
+ *
+ * @param projection Concrete projection the loop is instantiated for.
+ * @param chunk Overview chunk being refined.
+ * @param level Tiled-map level to draw, finer than the overview.
+ * @param traversal Back-to-front order used for the tiles and their rows.
+ */
+template <typename P>
+void Renderer::drawDetail(const P &projection, const HeightMap::Chunk &chunk, int level, const Traversal &traversal) {
+    const TiledMap::Level &info = _tiledMap->getLevel(level);
+    int tileSize = _tiledMap->getTileSize();
+    int stride = tileSize + 1;
+    int scale = 1 << (_overviewLevel - level);
+    int margin = CULL_MARGIN + _vfx->getMaxDisplacement();
+
+    int ownedX0 = chunk.x0 * scale;
+    int ownedY0 = chunk.y0 * scale;
+    int ownedX1 = std::min<long>(static_cast<long>(chunk.xEnd) * scale, info.width);
+    int ownedY1 = std::min<long>(static_cast<long>(chunk.yEnd) * scale, info.height);
+    int tx0 = ownedX0 / tileSize;
+    int ty0 = ownedY0 / tileSize;
+    int tx1 = std::min<int>((ownedX1 - 1) / tileSize, info.tilesX - 1);
+    int ty1 = std::min<int>((ownedY1 - 1) / tileSize, info.tilesY - 1);
+
+    for (int r = 0; r <= ty1 - ty0; r++) {
+        for (int c = 0; c <= tx1 - tx0; c++) {
+            int tx = traversal.reverseX ? tx1 - c : tx0 + c;
+            int ty = traversal.reverseY ? ty1 - r : ty0 + r;
+            const TiledMap::Tile &tile = _tiledMap->getTile(level, tx, ty);
+
+            int vx0 = tx * tileSize;
+            int vy0 = ty * tileSize;
+            int vx1 = std::min<int>(vx0 + tileSize, info.width - 1);
+            int vy1 = std::min<int>(vy0 + tileSize, info.height - 1);
+            if (!_camera.isBoxInRect(vx0 / scale, vy0 / scale, tile.minZ, (vx1 + scale - 1) / scale,
+                                     (vy1 + scale - 1) / scale, tile.maxZ, margin, _clip))
+                continue;
+
+            projectTile(projection, _tiledMap->acquireTile(level, tx, ty), vx0, vy0, vx1, vy1, scale);
+
+            int sx0 = std::max(ownedX0, vx0);
+            int sy0 = std::max(ownedY0, vy0);
+            int sx1 = std::min(ownedX1, tx == static_cast<int>(info.tilesX) - 1 ? vx1 + 1 : vx0 + tileSize);
+            int sy1 = std::min(ownedY1, ty == static_cast<int>(info.tilesY) - 1 ? vy1 + 1 : vy0 + tileSize);
 
-            if (_vfx->getWaveStatus()) {
-                auto wavedPoint = _vfx->waveDistortion(screenPoint, _time);
-                finalX = wavedPoint.first;
-                finalY = wavedPoint.second;
+            for (int rr = 0; rr < sy1 - sy0; rr++) {
+                int y = traversal.reverseY ? sy1 - 1 - rr : sy0 + rr;
+                for (int cc = 0; cc < sx1 - sx0; cc++) {
+                    int x = traversal.reverseX ? sx1 - 1 - cc : sx0 + cc;
+                    int index = (y - vy0) * stride + (x - vx0);
+                    const ProjectedVertex &vertex = _tileVertices[index];
+
+                    if (_fillStatus) {
+                        if (x == vx1 || y == vy1)
+                            continue;
+                        const ProjectedVertex &right = _tileVertices[index + 1];
+                        const ProjectedVertex &below = _tileVertices[index + stride];
+                        const ProjectedVertex &diagonal = _tileVertices[index + stride + 1];
+                        if (!(vertex.valid && right.valid && below.valid && diagonal.valid))
+                            continue;
+                        if (!(vertex.inFront && right.inFront && below.inFront && diagonal.inFront))
+                            continue;
+                        fillTriangle(vertex, right, diagonal);
+                        fillTriangle(vertex, diagonal, below);
+                        continue;
+                    }
+
+                    if (!vertex.valid)
+                        continue;
+                    if (x < vx1 && _tileVertices[index + 1].valid)
+                        drawVertexEdge(projection, vertex, _tileVertices[index + 1]);
+                    if (y < vy1 && _tileVertices[index + stride].valid)
+                        drawVertexEdge(projection, vertex, _tileVertices[index + stride]);
+                }
             }
+        }
+    }
+}
+
+/**
+ * @brief Transforms the vertices of one tile into the tile vertex cache.
+ *
+ * Same as projectChunk(), with fine vertex (x, y) placed at overview grid
+ * position (x / scale, y / scale).
+ *
+ * @param projection Concrete projection to apply.
+ * @param samples Tile samples returned by TiledMap::acquireTile().
+ * @param vx0 First column of the tile, in level vertices.
+ * @param vy0 First row of the tile, in level vertices.
+ * @param vx1 Last column of the tile inside the level.
+ * @param vy1 Last row of the tile inside the level.
+ * @param scale Level vertices per overview vertex.
+ */
+template <typename P>
+void Renderer::projectTile(const P &projection, const int32_t *samples, int vx0, int vy0, int vx1, int vy1, int scale) {
+    int stride = _tiledMap->getTileSize() + 1;
+    std::optional<int> noDataValue = _tiledMap->getNoDataValue();
+    int maxX = _heightMap.getMatrixWidth() - 1;
+    int maxY = _heightMap.getMatrixHeight() - 1;
+
+    for (int y = vy0; y <= vy1; y++) {
+        for (int x = vx0; x <= vx1; x++) {
+            int index = (y - vy0) * stride + (x - vx0);
+            ProjectedVertex &vertex = _tileVertices[index];
+            int z = samples[index];
 
-            if (_vfx->getGlitchStatus()) {
-                auto glitchedPoint = _vfx->glitch(screenPoint);
-                finalX = glitchedPoint.first;
-                finalY = glitchedPoint.second;
+            vertex.valid = !(noDataValue && z == *noDataValue);
+            if (!vertex.valid)
+                continue;
+            double overviewX = static_cast<double>(x) / scale;
+            double overviewY = static_cast<double>(y) / scale;
+            vertex.x = std::min(static_cast<int>(overviewX + 0.5), maxX);
+            vertex.y = std::min(static_cast<int>(overviewY + 0.5), maxY);
+            vertex.z = z;
+            vertex.camera = _camera.toCameraSpace(overviewX, overviewY, z);
+            vertex.inFront = _camera.isInFront(projection, vertex.camera);
+            if (vertex.inFront) {
+                vertex.screen = _camera.cameraToScreen(projection, vertex.camera);
+                applyEffects(vertex.screen);
+                if (_pickStatus)
+                    recordPick(vertex.x, vertex.y, vertex.screen, projection.depth(vertex.camera.x, vertex.camera.y, vertex.camera.z));
             }
+            if (_fillStatus) {
+                vertex.color = _colorManager.getColorFromHeight(vertex.x, vertex.y, z);
+                if (_depthTest)
+                    vertex.depth = projection.depth(vertex.camera.x, vertex.camera.y, vertex.camera.z);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Resets the depth buffer to "infinitely far" inside a region.
+ *
+ * @param rect Region to clear.
+ */
+void Renderer::clearDepth(const ScreenRect &rect) {
+    int width = _MLXHandler.getWidth();
+
+    for (int y = rect.y0; y < rect.y1; y++) {
+        float *row = _depthBuffer.data() + static_cast<size_t>(y) * width;
+        std::fill(row + rect.x0, row + rect.x1, std::numeric_limits<float>::infinity());
+    }
+}
+
+/**
+ * @brief Draws points and edges, or the filled surface, inside the current clip region.
+ *
+ * Resolves the active projection once and runs the drawing loops instantiated
+ * for that projection type, so no per-point dispatch happens in the hot loops.
+ * Contours, when shown, are retraced here only if their cache went stale.
+ */
+void Renderer::drawMap() {
+    if (_contourStatus)
+        _contours.update();
+
+    std::visit([this](const auto &projection) {
+        if (_fillStatus) {
+            drawSurface(projection);
+            return;
+        }
+        drawPoints(projection);
+        drawLines(projection);
+    }, _camera.getProjector()->getProjection());
+}
 
-            if (_vfx->getPulseWaveStatus()) {
-                auto PulseWavedPoint = _vfx->pulseWave(screenPoint, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
-                finalX = PulseWavedPoint.first;
-                finalY = PulseWavedPoint.second;
+/**
+ * @brief Updates the frame after a pure pan by scrolling the previous image.
+ *
+ * Shifts the existing pixels by the pan offset and only redraws the strips that
+ * were exposed along the edges. Falls back to a full redraw when effects are
+ * active (the frame is animated) or the shift exceeds the window size.
+ *
+ * The image must hold the previous frame, drawn with the same camera except for
+ * the pan.
+ *
+ * @param shiftX Horizontal screen displacement of the map, in pixels.
+ * @param shiftY Vertical screen displacement of the map, in pixels.
+ */
+void Renderer::drawScrolled(int shiftX, int shiftY) {
+    int width = _MLXHandler.getWidth();
+    int height = _MLXHandler.getHeight();
+
+    // Cells do not move with the pixels; the index stays stale until the next full frame.
+    _pickIndexValid = false;
+    if (_vfx->isActive() || abs(shiftX) >= width || abs(shiftY) >= height) {
+        _MLXHandler.clearImage(_MLXHandler.getImage());
+        draw();
+        return;
+    }
+
+    scrollImage(shiftX, shiftY);
+
+    if (shiftY > 0)
+        redrawRect({0, 0, width, shiftY});
+    else if (shiftY < 0)
+        redrawRect({0, height + shiftY, width, height});
+
+    int rowStart = std::max(0, shiftY);
+    int rowEnd = std::min(height, height + shiftY);
+    if (shiftX > 0)
+        redrawRect({0, rowStart, shiftX, rowEnd});
+    else if (shiftX < 0)
+        redrawRect({width + shiftX, rowStart, width, rowEnd});
+
+    _clip = {0, 0, width, height};
+}
+
+/**
+ * @brief Updates the frame after the heights of a grid box changed.
+ *
+ * Only the screen bounds of the box are cleared and redrawn, through the same
+ * clipped path as drawScrolled(). The frame is redrawn in full when effects are
+ * active or the bounds are unknown; see Camera::boxScreenRect().
+ *
+ * The image must hold the previous frame, drawn with the same camera.
+ *
+ * @param x0 Lowest X grid coordinate of the box.
+ * @param y0 Lowest Y grid coordinate of the box.
+ * @param x1 Highest X grid coordinate of the box.
+ * @param y1 Highest Y grid coordinate of the box.
+ * @param z0 Lowest raw height inside the box, before or after the change.
+ * @param z1 Highest raw height inside the box, before or after the change.
+ */
+void Renderer::redrawGridBox(int x0, int y0, int x1, int y1, int z0, int z1) {
+    int width = _MLXHandler.getWidth();
+    int height = _MLXHandler.getHeight();
+    ScreenRect rect;
+
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, _heightMap.getMatrixWidth() - 1);
+    y1 = std::min(y1, _heightMap.getMatrixHeight() - 1);
+    if (_vfx->isActive() || !_camera.boxScreenRect(x0, y0, z0, x1, y1, z1, rect)) {
+        _MLXHandler.clearImage(_MLXHandler.getImage());
+        draw();
+        return;
+    }
+
+    redrawRect({std::max(0, rect.x0 - CULL_MARGIN), std::max(0, rect.y0 - CULL_MARGIN),
+                std::min(width, rect.x1 + CULL_MARGIN), std::min(height, rect.y1 + CULL_MARGIN)});
+    _clip = {0, 0, width, height};
+}
+
+/**
+ * @brief Moves the image contents by (shiftX, shiftY) pixels.
+ *
+ * Pixels exposed by the shift keep stale data and must be redrawn. The depth
+ * buffer, when in use, is moved along so it keeps matching the image.
+ *
+ * @param shiftX Horizontal displacement in pixels.
+ * @param shiftY Vertical displacement in pixels.
+ */
+void Renderer::scrollImage(int shiftX, int shiftY) {
+    mlx_image_t *img = _MLXHandler.getImage();
+
+    scrollBuffer(img->pixels, static_cast<size_t>(img->width) * sizeof(uint32_t), sizeof(uint32_t), shiftX, shiftY);
+    if (_depthTest) {
+        scrollBuffer(reinterpret_cast<uint8_t *>(_depthBuffer.data()),
+                     static_cast<size_t>(_MLXHandler.getWidth()) * sizeof(float), sizeof(float), shiftX, shiftY);
+    }
+}
+
+/**
+ * @brief Shifts a window-sized 2D buffer by (shiftX, shiftY) cells.
+ *
+ * Rows are moved with memmove in an order that never overwrites rows still to be
+ * copied.
+ *
+ * @param data First byte of the buffer.
+ * @param stride Bytes per row.
+ * @param cellSize Bytes per cell.
+ * @param shiftX Horizontal displacement in cells.
+ * @param shiftY Vertical displacement in cells.
+ */
+void Renderer::scrollBuffer(uint8_t *data, size_t stride, size_t cellSize, int shiftX, int shiftY) {
+    int width = _MLXHandler.getWidth();
+    int height = _MLXHandler.getHeight();
+
+    int srcX = std::max(0, -shiftX);
+    int dstX = std::max(0, shiftX);
+    size_t rowBytes = static_cast<size_t>(width - abs(shiftX)) * cellSize;
+
+    if (shiftY > 0) {
+        for (int y = height - 1; y >= shiftY; y--) {
+            std::memmove(data + y * stride + dstX * cellSize,
+                         data + (y - shiftY) * stride + srcX * cellSize, rowBytes);
+        }
+    } else {
+        for (int y = 0; y < height + shiftY; y++) {
+            std::memmove(data + y * stride + dstX * cellSize,
+                         data + (y - shiftY) * stride + srcX * cellSize, rowBytes);
+        }
+    }
+}
+
+/**
+ * @brief Clears a screen region and redraws the map clipped to it.
+ *
+ * Only chunks whose projection reaches the region are transformed, and only
+ * pixels inside the region are written.
+ *
+ * @param rect Region to redraw.
+ */
+void Renderer::redrawRect(const ScreenRect &rect) {
+    if (rect.x0 >= rect.x1 || rect.y0 >= rect.y1)
+        return;
+
+    for (int y = rect.y0; y < rect.y1; y++) {
+        for (int x = rect.x0; x < rect.x1; x++) {
+            mlx_put_pixel(_MLXHandler.getImage(), x, y, 0x000000FF);
+        }
+    }
+
+    _clip = rect;
+    if (_depthTest)
+        clearDepth(rect);
+    if (_pickStatus)
+        clearPickIndex(rect);
+    drawMap();
+}
+
+/**
+ * @brief Empties the pick index cells lying entirely inside a region.
+ *
+ * Cells straddling the region's border keep their vertices, which may come from
+ * chunks that are not redrawn.
+ *
+ * @param rect Region about to be redrawn.
+ */
+void Renderer::clearPickIndex(const ScreenRect &rect) {
+    int rows = static_cast<int>(_pickIndex.size()) / _pickColumns;
+    int column0 = (rect.x0 + PICK_CELL - 1) / PICK_CELL;
+    int row0 = (rect.y0 + PICK_CELL - 1) / PICK_CELL;
+    int column1 = rect.x1 == _MLXHandler.getWidth() ? _pickColumns : rect.x1 / PICK_CELL;
+    int row1 = rect.y1 == _MLXHandler.getHeight() ? rows : rect.y1 / PICK_CELL;
+
+    for (int row = row0; row < row1; row++) {
+        for (int column = column0; column < column1; column++)
+            _pickIndex[static_cast<size_t>(row) * _pickColumns + column].vertex = -1;
+    }
+}
+
+/**
+ * @brief Records a projected vertex in the pick index if it is the front-most of its cell.
+ *
+ * @param x Column of the vertex.
+ * @param y Row of the vertex.
+ * @param screen Final screen position of the vertex.
+ * @param depth Depth of the vertex, smaller is closer.
+ */
+void Renderer::recordPick(int x, int y, std::pair<int, int> screen, float depth) {
+    if (screen.first < _clip.x0 || screen.first >= _clip.x1 || screen.second < _clip.y0 || screen.second >= _clip.y1)
+        return;
+
+    PickCell &cell = _pickIndex[static_cast<size_t>(screen.second / PICK_CELL) * _pickColumns + screen.first / PICK_CELL];
+    if (cell.vertex >= 0 && cell.depth <= depth)
+        return;
+    cell = {y * _heightMap.getMatrixWidth() + x, depth, screen.first, screen.second};
+}
+
+/**
+ * @brief Looks a screen position up in the pick index.
+ *
+ * Only the cell under the position and its eight neighbors can hold a vertex
+ * within PICK_RADIUS; the front-most of those wins. When none is that close,
+ * the nearest of the nine cells' vertices on screen is taken.
+ *
+ * @return False if no vertex was drawn in those cells.
+ */
+bool Renderer::lookupPickIndex(int screenX, int screenY, int &x, int &y) const {
+    if (screenX < 0 || screenY < 0 || screenX >= _MLXHandler.getWidth() || screenY >= _MLXHandler.getHeight())
+        return false;
+
+    int rows = static_cast<int>(_pickIndex.size()) / _pickColumns;
+    int column = screenX / PICK_CELL;
+    int row = screenY / PICK_CELL;
+    const PickCell *best = NULL;
+    bool underCursor = false;
+    long bestDistance = 0;
+
+    for (int r = std::max(0, row - 1); r <= std::min(rows - 1, row + 1); r++) {
+        for (int c = std::max(0, column - 1); c <= std::min(_pickColumns - 1, column + 1); c++) {
+            const PickCell &cell = _pickIndex[static_cast<size_t>(r) * _pickColumns + c];
+            if (cell.vertex < 0)
+                continue;
+            long dx = cell.screenX - screenX;
+            long dy = cell.screenY - screenY;
+            long distance = dx * dx + dy * dy;
+            if (std::abs(dx) <= PICK_RADIUS && std::abs(dy) <= PICK_RADIUS) {
+                if (!underCursor || cell.depth < best->depth)
+                    best = &cell;
+                underCursor = true;
+            } else if (!underCursor && (!best || distance < bestDistance)) {
+                best = &cell;
+                bestDistance = distance;
             }
+        }
+    }
+    if (!best)
+        return false;
+    x = best->vertex % _heightMap.getMatrixWidth();
+    y = best->vertex / _heightMap.getMatrixWidth();
+    return true;
+}
 
-            if (_vfx->getVortexDistortionStatus()) {
-                auto VortexDistortionedPoint = _vfx->vortexDistortion(screenPoint, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
-                finalX = VortexDistortionedPoint.first;
-                finalY = VortexDistortionedPoint.second;
+/**
+ * @brief Finds the grid vertex drawn under a screen position.
+ *
+ * While inspection or sculpting is on and the last frame was fully drawn, the
+ * answer comes from the pick index in constant time, whatever the projection. Otherwise chunks whose screen bounds
+ * miss the position by more than PICK_RADIUS pixels are skipped without
+ * touching their vertices, so the cost depends on the chunks under the cursor
+ * rather than on the map size. Among the vertices
+ * within PICK_RADIUS, the one nearest to the viewer wins; when none is that
+ * close, as between the vertices of a zoomed-in map, the nearest one on screen
+ * is taken. Effects are ignored.
+ *
+ * @param screenX Screen X coordinate.
+ * @param screenY Screen Y coordinate.
+ * @param x Set to the column of the vertex found.
+ * @param y Set to the row of the vertex found.
+ * @return False if no vertex is drawn near the position.
+ */
+bool Renderer::pickVertex(int screenX, int screenY, int &x, int &y) const {
+    if (_pickIndexValid)
+        return lookupPickIndex(screenX, screenY, x, y);
+    return std::visit([&](const auto &projection) {
+        return pickVertex(projection, screenX, screenY, x, y);
+    }, _camera.getProjector()->getProjection());
+}
+
+template <typename P>
+bool Renderer::pickVertex(const P &projection, int screenX, int screenY, int &x, int &y) const {
+    ScreenRect target = {screenX - PICK_RADIUS, screenY - PICK_RADIUS, screenX + PICK_RADIUS + 1, screenY + PICK_RADIUS + 1};
+    float bestDepth = std::numeric_limits<float>::infinity();
+    long bestDistance = std::numeric_limits<long>::max();
+    bool underCursor = false;
+    bool found = false;
+
+    for (const HeightMap::Chunk &chunk : _heightMap.getChunks()) {
+        if (chunk.noDataCount == (chunk.xEnd - chunk.x0) * (chunk.yEnd - chunk.y0))
+            continue;
+        if (!_camera.isBoxInRect(chunk.x0, chunk.y0, chunk.minZ, chunk.xMax, chunk.yMax, chunk.maxZ, 0, target))
+            continue;
+
+        for (int vy = chunk.y0; vy < chunk.yEnd; vy++) {
+            for (int vx = chunk.x0; vx < chunk.xEnd; vx++) {
+                if (chunk.noDataCount > 0 && _heightMap.isNoData(vx, vy))
+                    continue;
+
+                CameraPoint point = _camera.toCameraSpace(vx, vy, _heightMap.getZ(vx, vy));
+                if (!_camera.isInFront(projection, point))
+                    continue;
+                std::pair<int, int> screen = _camera.cameraToScreen(projection, point);
+                long dx = screen.first - screenX;
+                long dy = screen.second - screenY;
+
+                if (std::abs(dx) <= PICK_RADIUS && std::abs(dy) <= PICK_RADIUS) {
+                    float depth = projection.depth(point.x, point.y, point.z);
+                    if (underCursor && depth >= bestDepth)
+                        continue;
+                    underCursor = true;
+                    bestDepth = depth;
+                } else if (underCursor || dx * dx + dy * dy >= bestDistance) {
+                    continue;
+                } else {
+                    bestDistance = dx * dx + dy * dy;
+                }
+                x = vx;
+                y = vy;
+                found = true;
             }
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Draws all map points to the screen, applying VFX transformations and color interpolation.
+ *
+ * Iterates over the heightmap chunks, skipping those that project fully off-screen, transforms
+ * each point, applies effects, and draws colored pixels. No-data points and points behind the
+ * near plane of a perspective-family projection are skipped.
+ *
+ * @param projection Concrete projection the loop is instantiated for.
+ */
+template <typename P>
+void Renderer::drawPoints(const P &projection) {
+    int pointSize = 0;
+    int margin = CULL_MARGIN + pointSize / 2 + _vfx->getMaxDisplacement();
+    
+    for (const HeightMap::Chunk &chunk : _heightMap.getChunks()) {
+        if (chunk.noDataCount == (chunk.xEnd - chunk.x0) * (chunk.yEnd - chunk.y0))
+            continue;
+        if (!isChunkVisible(chunk, margin))
+            continue;
+
+        for (int y = chunk.y0; y < chunk.yEnd; y++) {
+            for (int x = chunk.x0; x < chunk.xEnd; x++) {
+                if (chunk.noDataCount > 0 && _heightMap.isNoData(x, y))
+                    continue;
+
+                int z = _heightMap.getZ(x, y);
+
+                CameraPoint point = _camera.toCameraSpace(x, y, z);
+                if (!_camera.isInFront(projection, point))
+                    continue;
+            
+                std::pair<int, int> screenPoint = _camera.cameraToScreen(projection, point);
+                applyEffects(screenPoint);
+                int finalX = screenPoint.first;
+                int finalY = screenPoint.second;
             
-            for (int i = -pointSize / 2; i <= pointSize / 2; i++) {
-                for (int j = -pointSize / 2; j <= pointSize / 2; j++) {
-                    int pixelX = finalX + i;
-                    int pixelY = finalY + j;
+                for (int i = -pointSize / 2; i <= pointSize / 2; i++) {
+                    for (int j = -pointSize / 2; j <= pointSize / 2; j++) {
+                        int pixelX = finalX + i;
+                        int pixelY = finalY + j;
                     
-                    if (pixelX >= 0 && pixelX < _MLXHandler.getWidth() && 
-                        pixelY >= 0 && pixelY < _MLXHandler.getHeight()) {
-                        int color = _colorManager.getColorFromHeight(x, y, z);
-                        mlx_put_pixel(_MLXHandler.getImage(), pixelX, pixelY, color);
+                        if (pixelX >= _clip.x0 && pixelX < _clip.x1 && 
+                            pixelY >= _clip.y0 && pixelY < _clip.y1) {
+                            if (_depthTest) {
+                                float depth = projection.depth(point.x, point.y, point.z);
+                                float &stored = _depthBuffer[static_cast<size_t>(pixelY) * _MLXHandler.getWidth() + pixelX];
+                                if (depth >= stored)
+                                    continue;
+                                stored = depth;
+                            }
+                            int color = _colorManager.getColorFromHeight(x, y, z);
+                            mlx_put_pixel(_MLXHandler.getImage(), pixelX, pixelY, color);
+                        }
                     }
                 }
             }
@@ -106,104 +739,500 @@ void Renderer::drawPoints() {
 /**
  * @brief Draws all wireframe edges between map points, applying VFX and color gradients.
  *
- * Connects adjacent points horizontally and vertically, applies effects, and draws lines with color gradients.
+ * Walks the static edge list built by the HeightMap, chunk by chunk. Chunks whose bounding box
+ * projects fully off-screen are skipped; for the others every vertex is transformed once, then
+ * the chunk's edges are drawn from those cached positions.
+ * Chunks, rows and columns are visited back to front (see backToFront()), so nearer edges are
+ * painted over farther ones where they cross.
+ * With perspective-family projections, edges are clipped against the near plane in camera space
+ * before being projected; with curved projections they are subdivided where they bend.
+ *
+ * @param projection Concrete projection the loop is instantiated for.
  */
-void Renderer::drawLines() {
-    for (int y = 0; y < _heightMap.getMatrixHeight(); y++) {
-        for (int x = 0; x < _heightMap.getMatrixWidth(); x++) {
-            int z = _heightMap.getZ(x, y);
+template <typename P>
+void Renderer::drawLines(const P &projection) {
+    int margin = CULL_MARGIN + _vfx->getMaxDisplacement();
+    const std::vector<int> &edgeRows = _heightMap.getEdgeRows();
+    Traversal traversal = backToFront(projection);
 
-            std::pair<int, int> screenPoint = _camera.worldToScreen(x, y, z);
-            
-            std::pair<int, int> finalPoint = screenPoint;
-            
-            if (_vfx->getJitterStatus()) {
-                finalPoint = _vfx->jitter(finalPoint);
-            }
-            if (_vfx->getWaveStatus()) {
-                finalPoint = _vfx->waveDistortion(finalPoint, _time);
+    forEachChunk(traversal, [&](const HeightMap::Chunk &chunk, int index) {
+        if (chunk.edgeBegin == chunk.edgeEnd || !isChunkVisible(chunk, margin))
+            return;
+
+        int level = detailLevel(chunk);
+        if (level < _overviewLevel) {
+            drawDetail(projection, chunk, level, traversal);
+            if (_contourStatus)
+                drawContours(projection, index);
+            return;
+        }
+
+        projectChunk(projection, chunk);
+
+        int rows = chunk.yEnd - chunk.y0;
+        for (int r = 0; r < rows; r++) {
+            int rowIndex = chunk.rowBegin + (traversal.reverseY ? rows - 1 - r : r);
+            int begin = edgeRows[rowIndex];
+            int end = edgeRows[rowIndex + 1];
+
+            if (traversal.reverseX) {
+                for (int i = end - 1; i >= begin; i--)
+                    drawGridEdge(projection, i);
+            } else {
+                for (int i = begin; i < end; i++)
+                    drawGridEdge(projection, i);
             }
-            if (_vfx->getGlitchStatus()) {
-                finalPoint = _vfx->glitch(finalPoint);
+        }
+
+        if (_contourStatus)
+            drawContours(projection, index);
+    });
+}
+
+/**
+ * @brief Fills every grid cell as two triangles, using per-vertex colors.
+ *
+ * Reuses the chunk culling, vertex cache and back-to-front walk of the wireframe
+ * path, so without depth testing nearer cells are painted over farther ones.
+ * Cells touching a no-data vertex or a vertex behind the near plane are skipped.
+ *
+ * @param projection Concrete projection the loop is instantiated for.
+ */
+template <typename P>
+void Renderer::drawSurface(const P &projection) {
+    int margin = CULL_MARGIN + _vfx->getMaxDisplacement();
+    int width = _heightMap.getMatrixWidth();
+    int height = _heightMap.getMatrixHeight();
+    Traversal traversal = backToFront(projection);
+
+    forEachChunk(traversal, [&](const HeightMap::Chunk &chunk, int index) {
+        if (chunk.xMax == chunk.x0 || chunk.yMax == chunk.y0 || !isChunkVisible(chunk, margin))
+            return;
+
+        int level = detailLevel(chunk);
+        if (level < _overviewLevel) {
+            drawDetail(projection, chunk, level, traversal);
+            if (_contourStatus)
+                drawContours(projection, index);
+            return;
+        }
+
+        projectChunk(projection, chunk);
+
+        int blockWidth = chunk.xMax - chunk.x0 + 1;
+        int columns = std::min(chunk.xEnd, width - 1) - chunk.x0;
+        int rows = std::min(chunk.yEnd, height - 1) - chunk.y0;
+
+        for (int r = 0; r < rows; r++) {
+            int row = traversal.reverseY ? rows - 1 - r : r;
+            for (int c = 0; c < columns; c++) {
+                int column = traversal.reverseX ? columns - 1 - c : c;
+                int index = row * blockWidth + column;
+
+                const ProjectedVertex &topLeft = _vertices[index];
+                const ProjectedVertex &topRight = _vertices[index + 1];
+                const ProjectedVertex &bottomLeft = _vertices[index + blockWidth];
+                const ProjectedVertex &bottomRight = _vertices[index + blockWidth + 1];
+
+                if (!(topLeft.valid && topRight.valid && bottomLeft.valid && bottomRight.valid))
+                    continue;
+                if (!(topLeft.inFront && topRight.inFront && bottomLeft.inFront && bottomRight.inFront))
+                    continue;
+
+                fillTriangle(topLeft, topRight, bottomRight);
+                fillTriangle(topLeft, bottomRight, bottomLeft);
             }
-            if (_vfx->getPulseWaveStatus()) {
-                finalPoint = _vfx->pulseWave(finalPoint, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
+        }
+
+        if (_contourStatus)
+            drawContours(projection, index);
+    });
+}
+
+/**
+ * @brief Draws the cached contour segments of one chunk.
+ *
+ * Called right after the chunk itself, so with a back-to-front traversal nearer
+ * chunks drawn later hide them. With hidden-line removal on they are depth
+ * tested too, pulled one grid step toward the viewer: a segment cuts across its
+ * cell's two triangles, so the surface it lies on must not hide it. Segments are short enough to need neither
+ * near-plane clipping nor subdivision: one with an endpoint behind the near
+ * plane is dropped.
+ *
+ * @param projection Concrete projection the loop is instantiated for.
+ * @param chunk Index of the chunk in HeightMap::getChunks().
+ */
+template <typename P>
+void Renderer::drawContours(const P &projection, int chunk) {
+    const std::vector<Contours::Segment> &segments = _contours.getSegments();
+    int color = static_cast<int>(_fillStatus ? CONTOUR_COLOR_ON_FILL : CONTOUR_COLOR);
+    float bias = static_cast<float>(_camera.getSpacing());
+
+    for (int i = _contours.getChunkBegin(chunk); i < _contours.getChunkEnd(chunk); i++) {
+        const Contours::Segment &segment = segments[i];
+        CameraPoint from = _camera.toCameraSpace(segment.x0, segment.y0, segment.z);
+        CameraPoint to = _camera.toCameraSpace(segment.x1, segment.y1, segment.z);
+
+        if (!_camera.isInFront(projection, from) || !_camera.isInFront(projection, to))
+            continue;
+
+        std::pair<int, int> start = _camera.cameraToScreen(projection, from);
+        std::pair<int, int> end = _camera.cameraToScreen(projection, to);
+        applyEffects(start);
+        applyEffects(end);
+        if (!isEdgeVisible(start, end))
+            continue;
+        if (_depthTest) {
+            drawLineDepthTested(start, end, color, color,
+                                projection.depth(from.x, from.y, from.z) - bias,
+                                projection.depth(to.x, to.y, to.z) - bias);
+        } else {
+            drawLineSafeWithGradient(start, end, color, color);
+        }
+    }
+}
+
+/**
+ * @brief Visits the chunks in the order given by a traversal.
+ *
+ * @param traversal Direction of the walk along each axis.
+ * @param visit Called with each chunk in turn, and its index in HeightMap::getChunks().
+ */
+template <typename F>
+void Renderer::forEachChunk(const Traversal &traversal, F visit) {
+    const std::vector<HeightMap::Chunk> &chunks = _heightMap.getChunks();
+    int chunkColumns = _heightMap.getChunkColumns();
+    int chunkRows = _heightMap.getChunkRows();
+
+    for (int cy = 0; cy < chunkRows; cy++) {
+        for (int cx = 0; cx < chunkColumns; cx++) {
+            int column = traversal.reverseX ? chunkColumns - 1 - cx : cx;
+            int row = traversal.reverseY ? chunkRows - 1 - cy : cy;
+            int index = row * chunkColumns + column;
+            visit(chunks[index], index);
+        }
+    }
+}
+
+/**
+ * @brief Picks the grid walking order that paints far geometry first.
+ *
+ * For affine projections depth is linear, so whether depth grows along the grid's
+ * X and Y axes only depends on the camera rotation and holds for the whole map.
+ * Walking each axis from its far end gives a valid painter's order for a height
+ * grid without sorting. Other projections keep the natural order.
+ *
+ * @param projection Concrete projection the map is drawn with.
+ * @return Whether columns and rows should be walked in decreasing order.
+ */
+template <typename P>
+Renderer::Traversal Renderer::backToFront(const P &projection) const {
+    Traversal traversal = {false, false};
+
+    if constexpr (P::IS_AFFINE) {
+        CameraPoint origin = _camera.toCameraSpace(0, 0, 0);
+        CameraPoint alongX = _camera.toCameraSpace(_heightMap.getMatrixWidth() - 1, 0, 0);
+        CameraPoint alongY = _camera.toCameraSpace(0, _heightMap.getMatrixHeight() - 1, 0);
+
+        double originDepth = projection.depth(origin.x, origin.y, origin.z);
+        traversal.reverseX = projection.depth(alongX.x, alongX.y, alongX.z) > originDepth;
+        traversal.reverseY = projection.depth(alongY.x, alongY.y, alongY.z) > originDepth;
+    }
+    (void)projection;
+    return traversal;
+}
+
+/**
+ * @brief Draws one edge of the chunk currently held in the vertex cache.
+ *
+ * @param projection Concrete projection the edge is drawn with.
+ * @param index Index of the edge in HeightMap::getEdges().
+ */
+template <typename P>
+void Renderer::drawGridEdge(const P &projection, int index) {
+    const HeightMap::Edge &edge = _heightMap.getEdges()[index];
+    drawVertexEdge(projection, _vertices[edge.from], _vertices[edge.to]);
+}
+
+/**
+ * @brief Clips and draws the edge between two projected vertices.
+ *
+ * @param projection Concrete projection the edge is drawn with.
+ * @param a Start vertex.
+ * @param b End vertex.
+ */
+template <typename P>
+void Renderer::drawVertexEdge(const P &projection, const ProjectedVertex &a, const ProjectedVertex &b) {
+    CameraPoint from = a.camera;
+    CameraPoint to = b.camera;
+    std::pair<int, int> start = a.screen;
+    std::pair<int, int> end = b.screen;
+
+    if (clipEdge(projection, from, a.inFront, to, b.inFront, start, end) && isEdgeVisible(start, end)) {
+        int startColor = _colorManager.getColorFromHeight(a.x, a.y, a.z);
+        int endColor = _colorManager.getColorFromHeight(b.x, b.y, b.z);
+        drawEdge(projection, from, to, start, end, startColor, endColor);
+    }
+}
+
+/**
+ * @brief Transforms every vertex of a chunk's block into the vertex cache.
+ *
+ * Covers [x0, xMax] x [y0, yMax], the range HeightMap::Edge indices refer to.
+ * Screen positions include effects and are left unset for vertices behind the
+ * near plane. No-data vertices are only flagged invalid. Colors and depths are
+ * filled in for surface mode, where every vertex is used by up to six triangles.
+ *
+ * @param projection Concrete projection the chunk is drawn with.
+ * @param chunk Chunk to transform.
+ */
+template <typename P>
+void Renderer::projectChunk(const P &projection, const HeightMap::Chunk &chunk) {
+    ProjectedVertex *vertex = _vertices.data();
+    bool masked = _heightMap.getNoDataValue().has_value();
+
+    for (int y = chunk.y0; y <= chunk.yMax; y++) {
+        for (int x = chunk.x0; x <= chunk.xMax; x++, vertex++) {
+            vertex->valid = !(masked && _heightMap.isNoData(x, y));
+            if (!vertex->valid)
+                continue;
+            vertex->x = x;
+            vertex->y = y;
+            vertex->z = _heightMap.getZ(x, y);
+            vertex->camera = _camera.toCameraSpace(x, y, vertex->z);
+            vertex->inFront = _camera.isInFront(projection, vertex->camera);
+            if (vertex->inFront) {
+                vertex->screen = _camera.cameraToScreen(projection, vertex->camera);
+                applyEffects(vertex->screen);
+                if (_pickStatus)
+                    recordPick(x, y, vertex->screen, projection.depth(vertex->camera.x, vertex->camera.y, vertex->camera.z));
             }
-            if (_vfx->getVortexDistortionStatus()) {
-                finalPoint = _vfx->vortexDistortion(finalPoint, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
+            if (_fillStatus) {
+                vertex->color = _colorManager.getColorFromHeight(x, y, vertex->z);
+                if (_depthTest)
+                    vertex->depth = projection.depth(vertex->camera.x, vertex->camera.y, vertex->camera.z);
             }
+        }
+    }
+}
 
-            if (x + 1 < _heightMap.getMatrixWidth()) {
-                int nextZ = _heightMap.getZ(x + 1, y);
-                std::pair<int, int> nextScreenPoint = _camera.worldToScreen(x + 1, y, nextZ);
+/**
+ * @brief Clips an edge at the near plane and reprojects the clipped endpoint.
+ *
+ * Edges fully behind the near plane are rejected. When one endpoint is behind it,
+ * that endpoint is replaced by the point where the edge crosses the plane, so the
+ * projection never divides by a vanishing depth.
+ *
+ * @param projection Concrete projection the edge is drawn with.
+ * @param from Camera-space start of the edge; moved onto the near plane if clipped.
+ * @param fromInFront Whether from passed Camera::isInFront().
+ * @param to Camera-space end of the edge; moved onto the near plane if clipped.
+ * @param toInFront Whether to passed Camera::isInFront().
+ * @param start Final screen start; replaced if from is clipped.
+ * @param end Final screen end; replaced if to is clipped.
+ * @return False if nothing of the edge is in front of the near plane.
+ */
+template <typename P>
+bool Renderer::clipEdge(const P &projection, CameraPoint &from, bool fromInFront, CameraPoint &to, bool toInFront,
+                        std::pair<int, int> &start, std::pair<int, int> &end) {
+    if (!fromInFront && !toInFront)
+        return false;
 
-                std::pair<int, int> nextFinal = nextScreenPoint;
-                
-                if (_vfx->getJitterStatus()) {
-                    nextFinal = _vfx->jitter(nextFinal);
-                }
-                if (_vfx->getWaveStatus()) {
-                    nextFinal = _vfx->waveDistortion(nextFinal, _time);
-                }
-                if (_vfx->getGlitchStatus()) {
-                    nextFinal = _vfx->glitch(nextFinal);
-                }
-                if (_vfx->getPulseWaveStatus()) {
-                    nextFinal = _vfx->pulseWave(nextFinal, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
-                }
-                if (_vfx->getVortexDistortionStatus()) {
-                    nextFinal = _vfx->vortexDistortion(nextFinal, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
-                }
+    if (!toInFront) {
+        to = _camera.clipToNearPlane(projection, from, to);
+        end = _camera.cameraToScreen(projection, to);
+        applyEffects(end);
+    } else if (!fromInFront) {
+        from = _camera.clipToNearPlane(projection, to, from);
+        start = _camera.cameraToScreen(projection, from);
+        applyEffects(start);
+    }
 
-                if ((finalPoint.first >= 0 && finalPoint.first < _MLXHandler.getWidth() && 
-                     finalPoint.second >= 0 && finalPoint.second < _MLXHandler.getHeight()) ||
-                    (nextFinal.first >= 0 && nextFinal.first < _MLXHandler.getWidth() && 
-                     nextFinal.second >= 0 && nextFinal.second < _MLXHandler.getHeight())) {
-                    int color1 = _colorManager.getColorFromHeight(x, y, z);
-                    int color2 = _colorManager.getColorFromHeight(x + 1, y, nextZ);
-                    drawLineSafeWithGradient(finalPoint, nextFinal, color1, color2);
-                }
-            }
+    return true;
+}
 
-            if (y + 1 < _heightMap.getMatrixHeight()) {
-                int nextZ = _heightMap.getZ(x, y + 1);
-                std::pair<int, int> nextScreenPoint = _camera.worldToScreen(x, y + 1, nextZ);
+/**
+ * @brief Draws an edge whose endpoints are already projected.
+ *
+ * Edges of curved projections are handed to drawCurvedEdge() unless effects are
+ * active; effects already displace vertices by more than the curvature error.
+ * Every other projection maps edges to straight segments and draws them directly.
+ *
+ * @param projection Concrete projection the edge is drawn with.
+ * @param from Camera-space start of the edge.
+ * @param to Camera-space end of the edge.
+ * @param start Final screen start.
+ * @param end Final screen end.
+ * @param startColor Color at the start point.
+ * @param endColor Color at the end point.
+ */
+template <typename P>
+void Renderer::drawEdge(const P &projection, const CameraPoint &from, const CameraPoint &to,
+                        std::pair<int, int> start, std::pair<int, int> end, int startColor, int endColor) {
+    if constexpr (P::IS_CURVED) {
+        if (!_vfx->isActive()) {
+            drawCurvedEdge(projection, from, to, start, end, startColor, endColor, 0);
+            return;
+        }
+    }
+    drawSegment(projection, from, to, start, end, startColor, endColor);
+}
 
-                std::pair<int, int> nextFinal = nextScreenPoint;
-                
-                if (_vfx->getJitterStatus()) {
-                    nextFinal = _vfx->jitter(nextFinal);
-                }
-                if (_vfx->getWaveStatus()) {
-                    nextFinal = _vfx->waveDistortion(nextFinal, _time);
-                }
-                if (_vfx->getGlitchStatus()) {
-                    nextFinal = _vfx->glitch(nextFinal);
-                }
-                if (_vfx->getPulseWaveStatus()) {
-                    nextFinal = _vfx->pulseWave(nextFinal, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
-                }
-                if (_vfx->getVortexDistortionStatus()) {
-                    nextFinal = _vfx->vortexDistortion(nextFinal, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
-                }
+/**
+ * @brief Draws one straight segment, depth tested when hidden-line removal is on.
+ *
+ * @param projection Concrete projection providing the depth of both ends.
+ * @param from Camera-space start of the segment.
+ * @param to Camera-space end of the segment.
+ * @param start Final screen start.
+ * @param end Final screen end.
+ * @param startColor Color at the start point.
+ * @param endColor Color at the end point.
+ */
+template <typename P>
+void Renderer::drawSegment(const P &projection, const CameraPoint &from, const CameraPoint &to,
+                           std::pair<int, int> start, std::pair<int, int> end, int startColor, int endColor) {
+    if (_depthTest) {
+        float startDepth = projection.depth(from.x, from.y, from.z);
+        float endDepth = projection.depth(to.x, to.y, to.z);
+        drawLineDepthTested(start, end, startColor, endColor, startDepth, endDepth);
+        return;
+    }
+    drawLineSafeWithGradient(start, end, startColor, endColor);
+}
 
-                if ((finalPoint.first >= 0 && finalPoint.first < _MLXHandler.getWidth() && 
-                     finalPoint.second >= 0 && finalPoint.second < _MLXHandler.getHeight()) ||
-                    (nextFinal.first >= 0 && nextFinal.first < _MLXHandler.getWidth() && 
-                     nextFinal.second >= 0 && nextFinal.second < _MLXHandler.getHeight())) {
-                    int startColor = _colorManager.getColorFromHeight(x, y, z);
-                    int endColor = _colorManager.getColorFromHeight(x, y + 1, nextZ);
-                    drawLineSafeWithGradient(finalPoint, nextFinal, startColor, endColor);
-                }
-            }
+/**
+ * @brief Draws an edge of a curved projection, splitting it where it bends.
+ *
+ * Projects the camera-space midpoint of the edge; if it lands more than a pixel
+ * away from the straight segment, both halves are drawn recursively. Subdivision
+ * stops after MAX_SUBDIVISION levels, when the edge cannot be split further in
+ * camera space, or when the midpoint falls behind the near plane.
+ *
+ * @param projection Concrete projection the edge is drawn with.
+ * @param from Camera-space start of the edge.
+ * @param to Camera-space end of the edge.
+ * @param start Screen position of from.
+ * @param end Screen position of to.
+ * @param startColor Color at the start point.
+ * @param endColor Color at the end point.
+ * @param level Current recursion depth.
+ */
+template <typename P>
+void Renderer::drawCurvedEdge(const P &projection, const CameraPoint &from, const CameraPoint &to,
+                              std::pair<int, int> start, std::pair<int, int> end,
+                              int startColor, int endColor, int level) {
+    bool splittable = level < MAX_SUBDIVISION &&
+                      (abs(to.x - from.x) > 1 || abs(to.y - from.y) > 1 || abs(to.z - from.z) > 1);
+    CameraPoint mid = {(from.x + to.x) / 2, (from.y + to.y) / 2, (from.z + to.z) / 2};
+
+    if (splittable && _camera.isInFront(projection, mid)) {
+        std::pair<int, int> midScreen = _camera.cameraToScreen(projection, mid);
+
+        double dx = end.first - start.first;
+        double dy = end.second - start.second;
+        double mx = midScreen.first - start.first;
+        double my = midScreen.second - start.second;
+        double cross = dx * my - dy * mx;
+        double lengthSq = dx * dx + dy * dy;
+        bool bent = (lengthSq == 0.0) ? (mx * mx + my * my > 1.0) : (cross * cross > lengthSq);
+
+        if (bent) {
+            int midColor = _colorManager.interpolateColor(startColor, endColor, 0.5f);
+            drawCurvedEdge(projection, from, mid, start, midScreen, startColor, midColor, level + 1);
+            drawCurvedEdge(projection, mid, to, midScreen, end, midColor, endColor, level + 1);
+            return;
         }
     }
+
+    drawSegment(projection, from, to, start, end, startColor, endColor);
+}
+
+/**
+ * @brief Runs a screen point through every active effect, in order.
+ *
+ * @param point Screen point straight out of the camera, displaced in place.
+ */
+void Renderer::applyEffects(std::pair<int, int> &point) {
+    if (_vfx->getJitterStatus()) {
+        _vfx->jitter(point);
+    }
+    if (_vfx->getWaveStatus()) {
+        _vfx->waveDistortion(point, _time);
+    }
+    if (_vfx->getGlitchStatus()) {
+        _vfx->glitch(point);
+    }
+    if (_vfx->getPulseWaveStatus()) {
+        _vfx->pulseWave(point, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
+    }
+    if (_vfx->getVortexDistortionStatus()) {
+        _vfx->vortexDistortion(point, _time, _MLXHandler.getWidth() / 2, _MLXHandler.getHeight() / 2);
+    }
+}
+
+/**
+ * @brief Checks whether any part of a chunk can land in the current clip region.
+ *
+ * Projects the chunk's 3D bounding box (grid extent and height range) through
+ * the camera and tests it against the clip region.
+ *
+ * @param chunk Chunk to test.
+ * @param margin Pixels of slack for rounding and active effects.
+ * @return False if the chunk is guaranteed to be fully outside the clip region.
+ */
+bool Renderer::isChunkVisible(const HeightMap::Chunk &chunk, int margin) const {
+    return _camera.isBoxInRect(chunk.x0, chunk.y0, chunk.minZ, chunk.xMax, chunk.yMax, chunk.maxZ, margin, _clip);
+}
+
+/**
+ * @brief Narrows the parametric range of a segment against one clip boundary.
+ *
+ * One Liang-Barsky step: the segment point at t is inside the boundary while
+ * p * t <= q.
+ *
+ * @return False if the remaining range is empty.
+ */
+static bool clipRange(double p, double q, double &t0, double &t1) {
+    if (p == 0.0)
+        return q >= 0.0;
+
+    double t = q / p;
+    if (p < 0.0)
+        t0 = std::max(t0, t);
+    else
+        t1 = std::min(t1, t);
+    return t0 <= t1;
+}
+
+/**
+ * @brief Decides whether an edge between two final screen points should be drawn.
+ *
+ * An edge is drawn when the segment crosses the current clip region, wherever its
+ * endpoints are. Since the clip region is always part of the screen, a region
+ * redrawn after a scroll gets exactly the edges a full redraw would give it.
+ *
+ * @param a First endpoint.
+ * @param b Second endpoint.
+ * @return True if the edge contributes pixels to the clip region.
+ */
+bool Renderer::isEdgeVisible(std::pair<int, int> a, std::pair<int, int> b) {
+    double dx = b.first - a.first;
+    double dy = b.second - a.second;
+    double t0 = 0.0;
+    double t1 = 1.0;
+
+    return clipRange(-dx, a.first - _clip.x0, t0, t1) &&
+           clipRange(dx, _clip.x1 - 1 - a.first, t0, t1) &&
+           clipRange(-dy, a.second - _clip.y0, t0, t1) &&
+           clipRange(dy, _clip.y1 - 1 - a.second, t0, t1);
 }
 
 /**
  * @brief Draws a line between two points with a color gradient, safely handling screen bounds.
  *
- * Uses Bresenham's algorithm and interpolates color between start and end points. Only draws pixels within screen bounds.
+ * Uses Bresenham's algorithm and interpolates color between start and end points. Only draws pixels within
+ * the current clip region.
  *
  * @param start Starting screen coordinates (x, y).
  * @param end Ending screen coordinates (x, y).
@@ -233,7 +1262,7 @@ void Renderer::drawLineSafeWithGradient(std::pair<int, int> start, std::pair<int
     int y = y1;
     
     while (true) {
-        if (x >= 0 && x < _MLXHandler.getWidth() && y >= 0 && y < _MLXHandler.getHeight()) {
+        if (x >= _clip.x0 && x < _clip.x1 && y >= _clip.y0 && y < _clip.y1) {
             int color;
             if (useGradient) {
                 float t = currentDistance / totalDistance;
@@ -260,4 +1289,196 @@ void Renderer::drawLineSafeWithGradient(std::pair<int, int> start, std::pair<int
             currentDistance = sqrt((x - x1) * (x - x1) + (y - y1) * (y - y1));
         }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Draws a gradient line, keeping only pixels closer than the depth buffer.
+ *
+ * The segment is clipped to the current clip region first, so off-screen parts
+ * cost nothing. The visible span is then walked with a fixed-point DDA that
+ * steps position, color channels and depth incrementally and writes straight
+ * into the image and depth buffer, without per-pixel calls or square roots.
+ *
+ * @param start Starting screen coordinates (x, y).
+ * @param end Ending screen coordinates (x, y).
+ * @param startColor Color at the start point.
+ * @param endColor Color at the end point.
+ * @param startDepth Depth at the start point, smaller is closer.
+ * @param endDepth Depth at the end point.
+ */
+void Renderer::drawLineDepthTested(std::pair<int, int> start, std::pair<int, int> end,
+                                   int startColor, int endColor, float startDepth, float endDepth) {
+    int dx = end.first - start.first;
+    int dy = end.second - start.second;
+    int steps = std::max(abs(dx), abs(dy));
+
+    double t0 = 0.0;
+    double t1 = 1.0;
+    if (!clipRange(-dx, start.first - _clip.x0, t0, t1) ||
+        !clipRange(dx, _clip.x1 - 1 - start.first, t0, t1) ||
+        !clipRange(-dy, start.second - _clip.y0, t0, t1) ||
+        !clipRange(dy, _clip.y1 - 1 - start.second, t0, t1))
+        return;
+
+    int first = static_cast<int>(std::ceil(t0 * steps));
+    int last = static_cast<int>(std::floor(t1 * steps));
+    int divisor = std::max(steps, 1);
+
+    int64_t stepX = static_cast<int64_t>(dx) * 65536 / divisor;
+    int64_t stepY = static_cast<int64_t>(dy) * 65536 / divisor;
+    int64_t fixX = static_cast<int64_t>(start.first) * 65536 + 0x8000 + stepX * first;
+    int64_t fixY = static_cast<int64_t>(start.second) * 65536 + 0x8000 + stepY * first;
+
+    int channel[4];
+    int channelStep[4];
+    for (int c = 0; c < 4; c++) {
+        int from = (startColor >> (24 - 8 * c)) & 0xFF;
+        int to = (endColor >> (24 - 8 * c)) & 0xFF;
+        channelStep[c] = (to - from) * 65536 / divisor;
+        channel[c] = from * 65536 + channelStep[c] * first;
+    }
+
+    float depthStep = (endDepth - startDepth) / divisor;
+    float depth = startDepth + depthStep * first;
+
+    mlx_image_t *img = _MLXHandler.getImage();
+    int width = _MLXHandler.getWidth();
+    float *depthBuffer = _depthBuffer.data();
+
+    for (int i = first; i <= last; i++) {
+        int x = static_cast<int>(fixX >> 16);
+        int y = static_cast<int>(fixY >> 16);
+
+        if (x >= _clip.x0 && x < _clip.x1 && y >= _clip.y0 && y < _clip.y1) {
+            float &stored = depthBuffer[static_cast<size_t>(y) * width + x];
+            if (depth < stored) {
+                stored = depth;
+                uint8_t *pixel = img->pixels + (static_cast<size_t>(y) * img->width + x) * sizeof(uint32_t);
+                pixel[0] = channel[0] >> 16;
+                pixel[1] = channel[1] >> 16;
+                pixel[2] = channel[2] >> 16;
+                pixel[3] = channel[3] >> 16;
+            }
+        }
+
+        fixX += stepX;
+        fixY += stepY;
+        for (int c = 0; c < 4; c++)
+            channel[c] += channelStep[c];
+        depth += depthStep;
+    }
+}
+
+/**
+ * @brief Fills a screen-space triangle with Gouraud-interpolated vertex colors.
+ *
+ * Scanline rasterizer driven by edge functions: for every row of the triangle's
+ * bounding box, clipped to the current clip region, the covered span is solved
+ * from the three edge functions, so slivers cost no more than their pixels.
+ * Color channels and depth are stepped by float adds along the span. Both
+ * windings are accepted. With depth testing on, pixels not closer than the
+ * depth buffer are left untouched.
+ *
+ * @param a First vertex.
+ * @param b Second vertex.
+ * @param c Third vertex.
+ */
+void Renderer::fillTriangle(const ProjectedVertex &a, const ProjectedVertex &b, const ProjectedVertex &c) {
+    const ProjectedVertex *v0 = &a;
+    const ProjectedVertex *v1 = &b;
+    const ProjectedVertex *v2 = &c;
+
+    int64_t area = static_cast<int64_t>(v1->screen.first - v0->screen.first) * (v2->screen.second - v0->screen.second) -
+                   static_cast<int64_t>(v2->screen.first - v0->screen.first) * (v1->screen.second - v0->screen.second);
+    if (area == 0)
+        return;
+    if (area < 0) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    int x0 = v0->screen.first, y0 = v0->screen.second;
+    int x1 = v1->screen.first, y1 = v1->screen.second;
+    int x2 = v2->screen.first, y2 = v2->screen.second;
+
+    int minX = std::max(std::min({x0, x1, x2}), _clip.x0);
+    int maxX = std::min(std::max({x0, x1, x2}), _clip.x1 - 1);
+    int minY = std::max(std::min({y0, y1, y2}), _clip.y0);
+    int maxY = std::min(std::max({y0, y1, y2}), _clip.y1 - 1);
+    if (minX > maxX || minY > maxY)
+        return;
+
+    // Edge function of the edge opposite each vertex at (minX, minY), and its steps.
+    int64_t stepX[3] = {y1 - y2, y2 - y0, y0 - y1};
+    int64_t stepY[3] = {x2 - x1, x0 - x2, x1 - x0};
+    int64_t edgeRow[3] = {stepY[0] * (minY - y1) + stepX[0] * (minX - x1),
+                          stepY[1] * (minY - y2) + stepX[1] * (minX - x2),
+                          stepY[2] * (minY - y0) + stepX[2] * (minX - x0)};
+
+    int channels = _depthTest ? 5 : 4;
+    float invArea = 1.0f / area;
+    float channelRow[5];
+    float channelStepX[5];
+    float channelStepY[5];
+    for (int k = 0; k < channels; k++) {
+        float value[3];
+        const ProjectedVertex *vertex[3] = {v0, v1, v2};
+        for (int i = 0; i < 3; i++)
+            value[i] = k < 4 ? (vertex[i]->color >> (24 - 8 * k)) & 0xFF : vertex[i]->depth;
+        channelRow[k] = (edgeRow[0] * value[0] + edgeRow[1] * value[1] + edgeRow[2] * value[2]) * invArea;
+        channelStepX[k] = (stepX[0] * value[0] + stepX[1] * value[1] + stepX[2] * value[2]) * invArea;
+        channelStepY[k] = (stepY[0] * value[0] + stepY[1] * value[1] + stepY[2] * value[2]) * invArea;
+    }
+
+    mlx_image_t *img = _MLXHandler.getImage();
+    int width = _MLXHandler.getWidth();
+
+    for (int y = minY; y <= maxY; y++) {
+        int spanBegin = 0;
+        int spanEnd = maxX - minX;
+        for (int i = 0; i < 3; i++) {
+            // Solve edgeRow + stepX * dx >= 0 for dx.
+            if (stepX[i] > 0)
+                spanBegin = std::max<int64_t>(spanBegin, edgeRow[i] >= 0 ? 0 : (-edgeRow[i] + stepX[i] - 1) / stepX[i]);
+            else if (stepX[i] < 0)
+                spanEnd = std::min<int64_t>(spanEnd, edgeRow[i] < 0 ? -1 : edgeRow[i] / -stepX[i]);
+            else if (edgeRow[i] < 0)
+                spanEnd = -1;
+        }
+
+        if (spanBegin <= spanEnd) {
+            float channel[5];
+            for (int k = 0; k < channels; k++)
+                channel[k] = channelRow[k] + channelStepX[k] * spanBegin;
+
+            int x = minX + spanBegin;
+            uint8_t *pixel = img->pixels + (static_cast<size_t>(y) * img->width + x) * sizeof(uint32_t);
+            float *stored = NULL;
+            if (_depthTest)
+                stored = _depthBuffer.data() + static_cast<size_t>(y) * width + x;
+
+            for (int count = spanEnd - spanBegin; count >= 0; count--, pixel += sizeof(uint32_t)) {
+                if (_depthTest) {
+                    if (channel[4] >= *stored) {
+                        stored++;
+                        for (int k = 0; k < channels; k++)
+                            channel[k] += channelStepX[k];
+                        continue;
+                    }
+                    *stored++ = channel[4];
+                }
+                pixel[0] = static_cast<uint8_t>(channel[0]);
+                pixel[1] = static_cast<uint8_t>(channel[1]);
+                pixel[2] = static_cast<uint8_t>(channel[2]);
+                pixel[3] = static_cast<uint8_t>(channel[3]);
+                for (int k = 0; k < channels; k++)
+                    channel[k] += channelStepX[k];
+            }
+        }
+
+        for (int i = 0; i < 3; i++)
+            edgeRow[i] += stepY[i];
+        for (int k = 0; k < channels; k++)
+            channelRow[k] += channelStepY[k];
+    }
+}
@@ -8,6 +8,9 @@
  */
 
 #include "../includes/UI.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 /**
  * @brief Constructs a UI object for displaying overlays and controls.
@@ -20,21 +23,23 @@
  * @param uiHeight Height of the UI overlay.
  */
 UI::UI(HeightMap *heightMap, MLXHandler *mlxhandler, int uiWidth, int uiHeight)
-	: _heightMap(heightMap), _MLXHandler(mlxhandler), _uiWidth(uiWidth), _uiHeight(uiHeight) {
+	: _heightMap(heightMap), _MLXHandler(mlxhandler), _uiWidth(uiWidth), _uiHeight(uiHeight), _inspectText(NULL) {
 	
 	_nPoints = std::to_string(_heightMap->getNPoints());
 	_nEdges = std::to_string(_heightMap->getNEdges());
 
 	_controlsOffset = _uiHeight * 0.025;
-	_interlineSpacing = 30;
+	_interlineSpacing = 28;
 
 	_controls = {
 		" ",
 		"			MOVEMENT:  , , ,  /",
 		"			ROTATION:  ,  /  ,  /  ,  /",
-		"			ZOOM:  ,  /        ",
-		"			HEIGHT:   ,",
-		"			RESET: ",
+		"			ZOOM:  ,  /        // ISO:  , /",
+		"			HEIGHT:   ,    // SUN:  ,  /",
+		"			RESET:   // DEPTH:   // FILL: ",
+		"			SCULPT:   // SIZE:  ,",
+		"			INSPECT: ",
 		" ",
 		"			AUTOROTATE: ",
 		"			JITTERING: ",
@@ -61,7 +66,7 @@ UI::UI(HeightMap *heightMap, MLXHandler *mlxhandler, int uiWidth, int uiHeight)
 		"			CANYONS: ",
 		"			LAVA: ",
 		"			KRZ: ",
-		"			B&W: ",
+		"			B&W:          // EQUALIZE: ",
 		" ",
 		"			POINTS:       // EDGES:",
 	};
@@ -70,9 +75,11 @@ UI::UI(HeightMap *heightMap, MLXHandler *mlxhandler, int uiWidth, int uiHeight)
 		"CONTROLS:",
 		"			          W A S D   LMB",
 		"			          Q E   I J   K L   RMB",
-		"			      - +   Scroll",
-		"		         UP DOWN",
-		"			       R",
+		"			      - +   Scroll         C [ ]",
+		"		         UP DOWN        N  , .",
+		"			       R           H          F",
+		"			        B          Z X",
+		"			         V",
 		"EFFECTS:",
 		"			            1",
 		"			           2",
@@ -99,10 +106,12 @@ UI::UI(HeightMap *heightMap, MLXHandler *mlxhandler, int uiWidth, int uiHeight)
 		"			         KP-3",
 		"			      KP-4",
 		"			     KP-5",
-		"			     KP-6",
+		"			     KP-6                  KP-0",
 		"INFO:",
 		"			        " + _nPoints + "            " + _nEdges,
 	};
+	_brushLine = 6;
+	_inspectLine = 7;
 }
 
 /**
@@ -142,24 +151,129 @@ void UI::fillBackground() {
 void UI::outputControls() {
 	clearTexts();
 
-	for (size_t i = 0; i < _controls.size(); ++i) {
-		mlx_image_t *textImage1 = _MLXHandler->getText1();
-		textImage1 = mlx_put_string(_MLXHandler->getMLX(), _controls[i].c_str(), 20, _controlsOffset + (_interlineSpacing * i));
+	for (size_t i = 0; i < _controls.size(); ++i)
+		outputLine(i);
+}
+
+/**
+ * @brief Redraws the two texts of one UI line, leaving the other lines' images alone.
+ *
+ * The line's images are drawn over in place, and only replaced when the new text
+ * is wider than they are.
+ *
+ * @param line Index into the control strings.
+ */
+void UI::outputLine(size_t line) {
+	if (_textImages.empty())
+		_textImages.assign(_controls.size() * 2, NULL);
+
+	int y = _controlsOffset + (_interlineSpacing * line);
+	putText(_textImages[line * 2], _controls[line], 20, y, 0);
+	putText(_textImages[line * 2 + 1], _controls2[line], 20, y, 0);
+	ColorText(_textImages[line * 2 + 1], 140, 200, 255);
+}
+
+/**
+ * @brief Draws a string with MLX42's built-in font into a text image.
+ *
+ * Renders like mlx_put_string(), but keeps the image and its window instance
+ * when the text fits, so updating a text allocates nothing.
+ *
+ * @param image Text image to draw into, or NULL to create one at (x, y). A new
+ *        image replaces it when the text is wider.
+ * @param text String to draw; unprintable characters are left blank.
+ * @param x Screen X coordinate of a newly created image.
+ * @param y Screen Y coordinate of a newly created image.
+ * @param capacity Minimum width, in characters, of a newly created image.
+ */
+void UI::putText(mlx_image_t *&image, const std::string &text, int x, int y, size_t capacity) {
+	const mlx_texture_t *font = mlx_get_font();
+	mlx_t *mlx = _MLXHandler->getMLX();
 
-		mlx_image_t *textImage2 = _MLXHandler->getText2();
-		textImage2 = mlx_put_string(_MLXHandler->getMLX(), _controls2[i].c_str(), 20, _controlsOffset + (_interlineSpacing * i));
-		ColorText(textImage2, 140, 200, 255);
-		
-		if (textImage1) {
-			_textImages.push_back(textImage1);
+	if (image && image->width < text.size() * GLYPH_WIDTH) {
+		mlx_delete_image(mlx, image);
+		image = NULL;
+	}
+	if (!image) {
+		image = mlx_new_image(mlx, std::max(text.size(), capacity) * GLYPH_WIDTH, font->height);
+		if (!image)
+			return;
+		if (mlx_image_to_window(mlx, image, x, y) == -1) {
+			mlx_delete_image(mlx, image);
+			image = NULL;
+			return;
 		}
+	}
 
-		if (textImage2) {
-			_textImages.push_back(textImage2);
+	std::memset(image->pixels, 0, static_cast<size_t>(image->width) * image->height * 4);
+	for (size_t i = 0; i < text.size(); i++) {
+		int32_t offset = mlx_get_texoffset(text[i]);
+		if (offset < 0)
+			continue;
+		for (uint32_t row = 0; row < font->height; row++) {
+			std::memcpy(image->pixels + (static_cast<size_t>(row) * image->width + i * GLYPH_WIDTH) * 4,
+						font->pixels + (static_cast<size_t>(row) * font->width + offset) * 4, GLYPH_WIDTH * 4);
 		}
 	}
 }
 
+/**
+ * @brief Points the INFO section at another height map and redraws its line.
+ *
+ * Used when a progressively loaded map replaces its preview.
+ *
+ * @param heightMap Height map now being rendered.
+ */
+void UI::setHeightMap(HeightMap *heightMap) {
+	_heightMap = heightMap;
+	_nPoints = std::to_string(_heightMap->getNPoints());
+	_nEdges = std::to_string(_heightMap->getNEdges());
+	_controls2.back() = "			        " + _nPoints + "            " + _nEdges;
+	outputLine(_controls.size() - 1);
+}
+
+/**
+ * @brief Shows the sculpting brush's mode and radius after its controls and redraws that line.
+ *
+ * @param mode Name of the brush mode.
+ * @param radius Brush radius in grid vertices.
+ */
+void UI::setBrushStatus(const std::string &mode, int radius) {
+	_controls[_brushLine] = "			SCULPT:   // SIZE:  ,  " + mode + " " + std::to_string(radius);
+	outputLine(_brushLine);
+}
+
+/**
+ * @brief Shows the inspected vertex after the INSPECT control.
+ *
+ * Only the value text is redrawn, and only when it changes, so hovering does
+ * not redraw the rest of the panel. Its image is created once, wide enough for
+ * any value, and drawn over afterwards.
+ *
+ * @param x Column of the vertex.
+ * @param y Row of the vertex.
+ * @param z Raw height of the vertex.
+ * @param color Color of the vertex, as 0xRRGGBBAA.
+ */
+void UI::setInspection(int x, int y, int z, uint32_t color) {
+	char text[64];
+	snprintf(text, sizeof(text), "%d,%d %d #%06X", x, y, z, color >> 8);
+	if (_inspectText && _inspection == text)
+		return;
+
+	_inspection = text;
+	putText(_inspectText, _inspection, 160, _controlsOffset + (_interlineSpacing * _inspectLine), sizeof(text) - 1);
+}
+
+/**
+ * @brief Blanks the inspected vertex's value text, keeping its image for the next one.
+ */
+void UI::clearInspection() {
+	if (_inspectText)
+		std::memset(_inspectText->pixels, 0, static_cast<size_t>(_inspectText->width) * _inspectText->height * 4);
+	_inspection.clear();
+}
+
 /**
  * @brief Colors the text in a given MLX image buffer with the specified RGB values.
  *
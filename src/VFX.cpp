@@ -60,6 +60,41 @@ bool &VFX::getChromaticAberrationStatus() {
     return (_chromaticAberrationStatus);
 }
 
+/**
+ * @brief Returns an upper bound, in pixels, on how far the active effects can move a point.
+ *
+ * Bounds are per axis. Effects are applied one after another, so their individual
+ * bounds add up. Used by the renderer to widen its culling tests while distortions
+ * are enabled.
+ *
+ * @return Maximum displacement of a screen point with the current toggles.
+ */
+int VFX::getMaxDisplacement() const {
+    float displacement = 0.0f;
+
+    if (_jitterStatus)
+        displacement += _jitterIntensity + 1.0f;
+    if (_waveStatus)
+        displacement += 6.0f;
+    if (_glitchStatus)
+        displacement += 6.0f;
+    if (_pulseWaveStatus)
+        displacement += 6.0f;
+    if (_vortexDistortionStatus)
+        displacement += std::fabs(_vortexDistortionIntensity) / 0.05f + 1.0f;
+
+    return static_cast<int>(std::ceil(displacement));
+}
+
+/**
+ * @brief Returns whether any point-distorting effect is enabled.
+ *
+ * Active effects animate over time, so frames cannot be reused while this is true.
+ */
+bool VFX::isActive() const {
+    return _jitterStatus || _waveStatus || _glitchStatus || _pulseWaveStatus || _vortexDistortionStatus;
+}
+
 void VFX::setJitterIntensity(float intensity){
     _jitterIntensity = intensity;
 }
@@ -91,19 +126,16 @@ void VFX::setChromaticAberrationStatus(bool status) {
 /**
  * @brief Applies jitter effect to a point, randomly displacing its coordinates.
  *
- * Uses a random distribution based on jitter intensity.
+ * Offsets are drawn uniformly from [-intensity, intensity] straight from the
+ * generator, without a distribution object per call.
  *
- * @param point Input screen coordinates (x, y).
- * @return Jittered screen coordinates (x, y).
+ * @param point Screen coordinates (x, y), displaced in place.
  */
-std::pair<int, int> VFX::jitter(std::pair <int, int> point){
-    static std::default_random_engine generator;
-    std::uniform_real_distribution<float> distribution(-_jitterIntensity, _jitterIntensity);
-    
-    int jitterX = point.first + distribution(generator);
-    int jitterY = point.second + distribution(generator);
+void VFX::jitter(std::pair<int, int> &point){
+    float scale = 2.0f * _jitterIntensity / (std::minstd_rand::max() - std::minstd_rand::min());
 
-    return {jitterX, jitterY};
+    point.first += static_cast<int>((_generator() - std::minstd_rand::min()) * scale - _jitterIntensity);
+    point.second += static_cast<int>((_generator() - std::minstd_rand::min()) * scale - _jitterIntensity);
 }
 
 /**
@@ -111,14 +143,13 @@ std::pair<int, int> VFX::jitter(std::pair <int, int> point){
  *
  * Uses time and position to compute the wave offset.
  *
- * @param point Input screen coordinates (x, y).
+ * @param point Screen coordinates (x, y), displaced in place.
  * @param time Animation time value.
- * @return Distorted screen coordinates (x, y).
  */
-std::pair<int, int> VFX::waveDistortion(std::pair<int, int> point, float time) {
+void VFX::waveDistortion(std::pair<int, int> &point, float time) const {
     int waveX = point.first + sin(time + point.second * 0.1) * 5;
     int waveY = point.second + cos(time + point.first * 0.1) * 5;
-    return {waveX, waveY};
+    point = {waveX, waveY};
 }
 
 /**
@@ -126,17 +157,13 @@ std::pair<int, int> VFX::waveDistortion(std::pair<int, int> point, float time) {
  *
  * Uses a random chance to apply a displacement.
  *
- * @param point Input screen coordinates (x, y).
- * @return Glitched screen coordinates (x, y).
+ * @param point Screen coordinates (x, y), displaced in place.
  */
-std::pair<int, int> VFX::glitch(std::pair<int, int> point) {
-    static std::default_random_engine generator;
-    std::uniform_int_distribution<int> displacement(-5, 5);
-    if (rand() % 10 < 2) {
-        point.first += displacement(generator);
-        point.second += displacement(generator);
+void VFX::glitch(std::pair<int, int> &point) {
+    if (_generator() % 10 < 2) {
+        point.first += static_cast<int>(_generator() % 11) - 5;
+        point.second += static_cast<int>(_generator() % 11) - 5;
     }
-    return point;
 }
 
 /**
@@ -144,13 +171,12 @@ std::pair<int, int> VFX::glitch(std::pair<int, int> point) {
  *
  * Uses distance from center and time to compute the wave offset.
  *
- * @param point Input screen coordinates (x, y).
+ * @param point Screen coordinates (x, y), displaced in place.
  * @param time Animation time value.
  * @param centerX X coordinate of the wave center.
  * @param centerY Y coordinate of the wave center.
- * @return Distorted screen coordinates (x, y).
  */
-std::pair<int, int> VFX::pulseWave(std::pair<int, int> point, float time, int centerX, int centerY) {
+void VFX::pulseWave(std::pair<int, int> &point, float time, int centerX, int centerY) const {
     float dx = point.first - centerX;
     float dy = point.second - centerY;
     float distance = sqrt(dx*dx + dy*dy);
@@ -163,7 +189,7 @@ std::pair<int, int> VFX::pulseWave(std::pair<int, int> point, float time, int ce
     int newX = point.first + dirX * waveFactor;
     int newY = point.second + dirY * waveFactor;
     
-    return {newX, newY};
+    point = {newX, newY};
 }
 
 /**
@@ -171,20 +197,19 @@ std::pair<int, int> VFX::pulseWave(std::pair<int, int> point, float time, int ce
  *
  * Uses distance from center and time to compute the rotation angle.
  *
- * @param point Input screen coordinates (x, y).
+ * @param point Screen coordinates (x, y), displaced in place.
  * @param time Animation time value.
  * @param centerX X coordinate of the vortex center.
  * @param centerY Y coordinate of the vortex center.
- * @return Distorted screen coordinates (x, y).
  */
-std::pair<int, int> VFX::vortexDistortion(std::pair<int, int> point, float time, int centerX, int centerY) {
+void VFX::vortexDistortion(std::pair<int, int> &point, float time, int centerX, int centerY) const {
     float dx = point.first - centerX;
     float dy = point.second - centerY;
     
     float distance = sqrt(dx*dx + dy*dy);
 
     if (distance < 5.0f) {
-        return point;
+        return;
     }
     
     float angle = _vortexDistortionIntensity * sin(time * 0.5) / (distance * 0.05);
@@ -195,7 +220,7 @@ std::pair<int, int> VFX::vortexDistortion(std::pair<int, int> point, float time,
     int newX = centerX + (dx * cosA - dy * sinA);
     int newY = centerY + (dx * sinA + dy * cosA);
     
-    return {newX, newY};
+    point = {newX, newY};
 }
 
 /**
@@ -203,10 +228,9 @@ std::pair<int, int> VFX::vortexDistortion(std::pair<int, int> point, float time,
  *
  * Used for rendering color channel separation effects.
  *
- * @param point Input screen coordinates (x, y).
+ * @param point Screen coordinates (x, y), offset in place.
  * @param channelOffset Offset to apply for the color channel.
- * @return Offset screen coordinates (x, y).
  */
-std::pair<int, int> VFX::chromaticAberration(std::pair<int, int> point, int channelOffset) {
-    return {point.first + channelOffset, point.second};
+void VFX::chromaticAberration(std::pair<int, int> &point, int channelOffset) const {
+    point.first += channelOffset;
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+/**
+ * @file WorkerPool.cpp
+ * @brief Implements the WorkerPool class, persistent threads for per-frame parallel loops.
+ */
+
+#include "../includes/WorkerPool.hpp"
+#include <algorithm>
+
+/**
+ * @brief Starts one thread per hardware thread, minus the caller's.
+ */
+WorkerPool::WorkerPool()
+	: _task(NULL), _context(NULL), _bands(0), _nextBand(0), _running(0), _generation(0), _stop(false) {
+	int count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+	for (int i = 0; i < count; i++)
+		_threads.emplace_back(&WorkerPool::work, this);
+}
+
+/**
+ * @brief Stops and joins the threads.
+ */
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_wake.notify_all();
+	for (std::thread &thread : _threads)
+		thread.join();
+}
+
+/**
+ * @brief The process-wide pool, started on first use.
+ */
+WorkerPool &WorkerPool::shared() {
+	static WorkerPool pool;
+	return pool;
+}
+
+/**
+ * @brief Number of threads a job runs on, the caller's included.
+ */
+int WorkerPool::getThreadCount() const {
+	return static_cast<int>(_threads.size()) + 1;
+}
+
+/**
+ * @brief Publishes a job to the threads, runs bands on the caller and waits for the rest.
+ *
+ * @param bands Number of bands.
+ * @param task Function called once per band.
+ * @param context First argument of task.
+ */
+void WorkerPool::dispatch(int bands, Task task, void *context) {
+	if (bands <= 1 || _threads.empty() || !_busy.try_lock()) {
+		for (int band = 0; band < bands; band++)
+			task(context, band);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_task = task;
+		_context = context;
+		_bands = bands;
+		_nextBand = 0;
+		_running = static_cast<int>(_threads.size());
+		_generation++;
+	}
+	_wake.notify_all();
+	runBands();
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_done.wait(lock, [this]() { return _running == 0; });
+	}
+	_busy.unlock();
+}
+
+/**
+ * @brief Takes bands of the current job until none is left.
+ */
+void WorkerPool::runBands() {
+	for (int band = _nextBand++; band < _bands; band = _nextBand++)
+		_task(_context, band);
+}
+
+/**
+ * @brief Thread body: waits for each new job and helps run it.
+ */
+void WorkerPool::work() {
+	size_t seen = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [&]() { return _stop || _generation != seen; });
+			if (_stop)
+				return;
+			seen = _generation;
+		}
+		runBands();
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (--_running == 0)
+			_done.notify_one();
+	}
+}
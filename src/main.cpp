@@ -8,22 +8,52 @@
  *
  * Expected usage:
  * @code
- * ./FDF++ <map_file_or_string>
+ * ./FDF++ <map_file_or_string> [no_data_value]
+ * ./FDF++ <map.fdft> [memory_budget_mib]
+ * ./FDF++ --tile <map.fdf> <map.fdft> [no_data_value]
+ * ./FDF++ --stream <pipe_or_-> [no_data_value]
+ * ./FDF++ --play <directory_or_glob> [frames_per_second] [no_data_value]
+ * ./FDF++ --bench <map_file_or_string> [frames]
  * @endcode
+ *
+ * When a no-data value is given (e.g. -1 for ocean DEMs), cells holding it are
+ * neither colored nor drawn. Map files are read on a background thread; unless
+ * a small map is read within MapLoader::PREVIEW_DELAY_MS, a subsampled preview
+ * is shown and refined until the whole map is in. The --tile form converts a
+ * text map into a tiled .fdft file and exits; .fdft maps are rendered out of
+ * core, paging tiles in within the given memory budget. The --stream form shows
+ * live height frames read from a named pipe, or stdin for "-". The --play form
+ * animates a sequence of .fdf maps of the same grid size, parsed ahead on a
+ * background thread. The --bench form auto-rotates the map for a number of
+ * frames, prints their timings and exits with 1 if any of them allocated
+ * (counted in builds made with "make bench").
+ *
+ * The height map is built on a worker thread while the window is created, and
+ * a one-line startup report with the time to the first frame is printed once
+ * it has been drawn. The map text is held in a LoadArena and released as soon
+ * as its rows have been parsed.
  */
 
+#include "../includes/mapHandler/FrameSequence.hpp"
+#include "../includes/mapHandler/HeightStream.hpp"
 #include "../includes/mapHandler/MapBuilder.hpp"
+#include "../includes/mapHandler/MapLoader.hpp"
 #include "../includes/mapHandler/MapParser.hpp"
+#include "../includes/mapHandler/TiledMap.hpp"
 #include "../includes/projections/Projector.hpp"
+#include "../includes/Benchmark.hpp"
 #include "../includes/VFX.hpp"
 #include "../includes/FDF.hpp"
 #include "../includes/UI.hpp"
+#include <chrono>
+#include <future>
 
 /**
  * @brief Main entry point. Sets up the FDF++ rendering pipeline.
  *
  * Initializes and connects the following components:
- * - MapBuilder: Parses the map input (file or inline string).
+ * - MapBuilder: Builds the map from an inline string.
+ * - MapLoader: Reads map files in the background, serving previews meanwhile.
  * - MLXHandler: Handles window creation and MLX42 interactions.
  * - Projector: Manages the type of projection used.
  * - VFX: Configures visual effects.
@@ -34,28 +64,125 @@
  * Runs the main render loop and cleans up all allocated resources.
  *
  * @param argc Number of command-line arguments.
- * @param argv Command-line arguments. Expects one argument: the map input.
+ * @param argv Command-line arguments. Expects the map input, optionally followed
+ *        by the no-data value (or the memory budget for .fdft maps), or the
+ *        --tile conversion, --stream, --play or --bench arguments.
  * @return Exit code (0 on success, 1 on error).
  */
 int main(int argc, char **argv){
-	if (argc != 2){
-		std::cerr << "Bad arguments!!(Try ./FDF++ <string/map>)" << std::endl;
+	if (argc >= 2 && std::string(argv[1]) == "--tile" && (argc == 4 || argc == 5)){
+		try{
+			std::optional<int> noDataValue;
+			if (argc == 5)
+				noDataValue = std::stoi(argv[4]);
+			TiledMap::convert(argv[2], argv[3], noDataValue);
+		} catch (const std::exception &e){
+			std::cout << "Exception caught: " << e.what() << std::endl;
+			return (1);
+		}
+		return (0);
+	}
+	bool streaming = argc >= 2 && std::string(argv[1]) == "--stream";
+	bool playing = argc >= 2 && std::string(argv[1]) == "--play";
+	bool benchmarking = argc >= 2 && std::string(argv[1]) == "--bench";
+	int first = streaming || playing || benchmarking ? 2 : 1;
+	if (argc != first + 1 && argc != first + 2 && !(playing && argc == first + 3)){
+		std::cerr << "Bad arguments!!(Try ./FDF++ <string/map> [no_data_value])" << std::endl;
+		std::cerr << "                (or ./FDF++ --tile <map.fdf> <map.fdft> [no_data_value])" << std::endl;
+		std::cerr << "                (or ./FDF++ --stream <pipe_or_-> [no_data_value])" << std::endl;
+		std::cerr << "                (or ./FDF++ --play <directory_or_glob> [frames_per_second] [no_data_value])" << std::endl;
+		std::cerr << "                (or ./FDF++ --bench <string/map> [frames])" << std::endl;
 		exit (1);
 	}
 	
 	MapBuilder *builder = NULL;
+	MapLoader *loader = NULL;
 	MLXHandler *mlx = NULL;
 	MapParser *parser = NULL;
 	Projector *projector = NULL;
-	VFX *vfx;
-	UI *ui;
+	VFX *vfx = NULL;
+	UI *ui = NULL;
 	
 	FDF *fdf = NULL;
+	TiledMap *tiles = NULL;
+	HeightStream *stream = NULL;
+	FrameSequence *sequence = NULL;
+	Benchmark *benchmark = NULL;
 	
 	try{	
-		std::string input = std::string(argv[1]);
-		builder = new MapBuilder(input);
+		std::string input = std::string(argv[first]);
+		std::optional<int> noDataValue;
+		size_t memoryBudget = TiledMap::DEFAULT_MEMORY_BUDGET;
+		int framesPerSecond = FrameSequence::DEFAULT_FPS;
+		if (playing){
+			if (argc >= first + 2)
+				framesPerSecond = std::stoi(argv[first + 1]);
+			if (argc == first + 3)
+				noDataValue = std::stoi(argv[first + 2]);
+		} else if (benchmarking)
+			benchmark = new Benchmark(argc == first + 2 ? std::stoi(argv[first + 1]) : Benchmark::DEFAULT_FRAMES);
+		else if (argc == first + 2 && !streaming && TiledMap::isTiledPath(input))
+			memoryBudget = static_cast<size_t>(std::stoul(argv[first + 1])) << 20;
+		else if (argc == first + 2)
+			noDataValue = std::stoi(argv[first + 1]);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		auto elapsedMs = [start](){
+			return (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+		};
+
+		if (!streaming && !playing){
+			if (TiledMap::isTiledPath(input))
+				tiles = new TiledMap(input, memoryBudget);
+			else if (MapBuilder::checkInputType(input))
+				loader = new MapLoader(input);
+			else
+				builder = new MapBuilder(input);
+		}
+
+		// The height map is read, parsed and built while the window is created.
+		bool complete = true;
+		long mapMs = 0;
+		std::future<HeightMap> heightMap = std::async(std::launch::async, [&](){
+			if (streaming){
+				stream = new HeightStream(input);
+				HeightStream::Region region;
+				HeightMap live(stream->getWidth(), stream->getHeight(), *stream->acquireFrame(region), noDataValue);
+				mapMs = elapsedMs();
+				return (live);
+			}
+			if (playing){
+				sequence = new FrameSequence(input, framesPerSecond);
+				FrameSequence::Region region;
+				HeightMap opening(sequence->getWidth(), sequence->getHeight(), *sequence->acquireFrame(region), noDataValue);
+				mapMs = elapsedMs();
+				return (opening);
+			}
+
+			LoadArena text;
+			std::vector<std::string_view> rows;
+			if (builder != NULL)
+				rows = builder->takeMap(text);
+			else if (loader != NULL){
+				complete = loader->waitUntilDone(std::chrono::milliseconds(MapLoader::PREVIEW_DELAY_MS))
+					&& loader->getExpectedPoints() <= MapLoader::DIRECT_POINTS;
+				rows = complete ? loader->takeRows(text) : loader->getPreview(text);
+			}
+
+			if (tiles != NULL){
+				const TiledMap::Level &level = tiles->getLevel(tiles->getOverviewLevel());
+				HeightMap overview(level.width, level.height, tiles->readLevel(tiles->getOverviewLevel()),
+					tiles->getNoDataValue());
+				mapMs = elapsedMs();
+				return (overview);
+			}
+			HeightMap map(rows, noDataValue, &text);
+			mapMs = elapsedMs();
+			return (map);
+		});
+
 		mlx = new MLXHandler(1920, 1080, "FDF++");
+		long windowMs = elapsedMs();
 
 		projector = new Projector();
 		projector->setType(1);
@@ -63,31 +190,60 @@ int main(int argc, char **argv){
 		vfx = new VFX();
 		
 		
-		fdf = new FDF(builder->getMap(), projector, *mlx, vfx);
+		fdf = new FDF(heightMap.get(), projector, *mlx, vfx);
+		if (tiles != NULL)
+			fdf->getRenderer()->setTiledMap(tiles, tiles->getOverviewLevel());
+		if (loader != NULL && complete){
+			delete loader;
+			loader = NULL;
+		}
 		mlx->setFDF(fdf);
 
 		ui = new UI(fdf->getHeightMap(), mlx, mlx->getUIWidth(), mlx->getUIHeight());
 		ui->fillBackground();
 		ui->outputControls();
+		mlx->setOverlay(ui);
 		
 		parser = new MapParser(fdf->getMatrix());
 		parser->parseMap();
 
+		mlx->setLoader(loader);
+		mlx->setStream(stream);
+		mlx->setSequence(sequence);
+		mlx->setBenchmark(benchmark);
 		fdf->draw();
+		std::cout << "Startup: window " << windowMs << " ms, " << (complete ? "map " : "preview ")
+			<< mapMs << " ms, first frame " << elapsedMs() << " ms" << std::endl;
 		mlx->handleEvents();
 		mlx_loop(mlx->getMLX());
 
+		if (sequence != NULL)
+			std::cout << "Playback: " << sequence->getLateFrames() << " frames shown late" << std::endl;
+		bool passed = true;
+		if (benchmark != NULL){
+			benchmark->report();
+			passed = benchmark->hasPassed();
+		}
 		mlx->cleanup();
 		delete builder;
+		delete loader;
 		delete mlx;
 		delete parser;
 		delete projector;
 		delete vfx;
 		delete ui;
 		delete fdf;
+		delete tiles;
+		delete stream;
+		delete sequence;
+		delete benchmark;
+		if (!passed)
+			return (1);
 	} catch (const std::exception &e){
 		if (builder != NULL)
 			delete builder;
+		if (loader != NULL)
+			delete loader;
 		if (ui != NULL)
 			delete ui;
 		if (mlx != NULL)
@@ -100,6 +256,14 @@ int main(int argc, char **argv){
 			delete vfx;
 		if (fdf != NULL)
 			delete fdf;
+		if (tiles != NULL)
+			delete tiles;
+		if (stream != NULL)
+			delete stream;
+		if (sequence != NULL)
+			delete sequence;
+		if (benchmark != NULL)
+			delete benchmark;
 		std::cout << "Exception caught: " << e.what() << std::endl;
 		return (1);
 	}
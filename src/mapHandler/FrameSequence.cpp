@@ -0,0 +1,270 @@
+/**
+# * @file FrameSequence.cpp
+# * @brief Implements the FrameSequence class for .fdf animation playback.
+# *
+# * The reader thread owns the file buffer and the ring slots that are neither ready nor
+# * held by the renderer; the mutex only guards the slot counts, so parsing never blocks
+# * the render loop.
+# */
+
+#include "../../includes/mapHandler/FrameSequence.hpp"
+#include "../../includes/mapHandler/MapParser.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <glob.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Lists the frames and parses the first one, which sets the grid size.
+ *
+ * The reader thread starts prefetching the following frames right away.
+ *
+ * @param pattern Directory holding the .fdf frames, or a glob pattern matching them.
+ * @param framesPerSecond Playback rate, clamped to [1, MAX_FPS].
+ * @throws BadSequenceException if no file matches.
+ * @throws BadFrameException if the first frame cannot be read or is empty.
+ */
+FrameSequence::FrameSequence(const std::string &pattern, int framesPerSecond)
+	: _width(0), _height(0), _regions(), _next(0), _ready(0), _held(false), _due(), _late(0),
+	  _stop(false){
+	struct stat info;
+	std::string files = pattern;
+	if (stat(pattern.c_str(), &info) == 0 && S_ISDIR(info.st_mode))
+		files = pattern + "/*.fdf";
+
+	glob_t matches;
+	if (glob(files.c_str(), 0, NULL, &matches) == 0) {
+		for (size_t i = 0; i < matches.gl_pathc; i++)
+			_paths.push_back(matches.gl_pathv[i]);
+	}
+	globfree(&matches);
+	if (_paths.empty())
+		throw (BadSequenceException());
+
+	readFile(_paths[0]);
+	parseFrame(NULL);
+	if (_width == 0)
+		throw (BadFrameException());
+	for (std::vector<int> &grid : _ring)
+		grid.assign(static_cast<size_t>(_width) * _height, 0);
+	parseFrame(_ring[0].data());
+	_regions[0] = {0, 0, _width, _height};
+	_ready = 1;
+
+	framesPerSecond = std::max(1, std::min(framesPerSecond, MAX_FPS));
+	_period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(1.0 / framesPerSecond));
+
+	if (_paths.size() > 1)
+		_reader = std::thread(&FrameSequence::read, this);
+}
+
+/**
+ * @brief Stops the reader thread.
+ */
+FrameSequence::~FrameSequence(){
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_space.notify_one();
+	if (_reader.joinable())
+		_reader.join();
+}
+
+int FrameSequence::getWidth() const{
+	return (_width);
+}
+
+int FrameSequence::getHeight() const{
+	return (_height);
+}
+
+/**
+ * @brief Number of frames shown a whole period or more after they were due.
+ */
+size_t FrameSequence::getLateFrames() const{
+	return (_late);
+}
+
+/**
+ * @brief Takes the next frame once it is due.
+ *
+ * Frames are due every 1 / framesPerSecond seconds; the schedule only restarts
+ * when a frame comes a whole period late, so the average rate stays exact. The
+ * frame taken by the previous call is handed back to the reader.
+ *
+ * @param region Set to the cells that differ from the previous frame.
+ * @return getWidth() * getHeight() heights, row-major, or NULL if no frame is
+ *         due or the reader has not parsed it yet.
+ */
+const std::vector<int> *FrameSequence::acquireFrame(Region &region){
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (now < _due)
+		return (NULL);
+
+	size_t slot;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_ready == 0)
+			return (NULL);
+		slot = _next;
+		_next = (_next + 1) % RING_SIZE;
+		_ready--;
+		_held = true;
+	}
+	_space.notify_one();
+
+	if (_due != std::chrono::steady_clock::time_point() && now - _due >= _period)
+		_late++;
+	_due += _period;
+	if (_due <= now)
+		_due = now + _period;
+	region = _regions[slot];
+	return (&_ring[slot]);
+}
+
+/**
+ * @brief Reader thread body: parses the frames ahead, looping, until stopped.
+ *
+ * A frame is parsed into the slot after the last ready one, and compared with
+ * that one, which the renderer only reads.
+ */
+void FrameSequence::read(){
+	size_t frame = 0;
+	try {
+		while (true) {
+			frame = (frame + 1) % _paths.size();
+			readFile(_paths[frame]);
+
+			size_t slot;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_space.wait(lock, [this](){ return (_stop || _ready + _held < RING_SIZE); });
+				if (_stop)
+					break;
+				slot = (_next + _ready) % RING_SIZE;
+			}
+			parseFrame(_ring[slot].data());
+			_regions[slot] = changedRegion(_ring[(slot + RING_SIZE - 1) % RING_SIZE], _ring[slot], _width, _height);
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			_ready++;
+		}
+	} catch (const std::exception &e) {
+		std::cout << "Exception caught: " << e.what() << std::endl;
+	}
+}
+
+/**
+ * @brief Reads a whole file into the text buffer, NUL-terminated.
+ *
+ * The buffer keeps its capacity, so frames of similar size do not reallocate it.
+ *
+ * @throws BadFrameException if the file cannot be read.
+ */
+void FrameSequence::readFile(const std::string &path){
+	int fd = open(path.c_str(), O_RDONLY);
+	struct stat info;
+	if (fd < 0 || fstat(fd, &info) != 0) {
+		if (fd >= 0)
+			close(fd);
+		throw (BadFrameException());
+	}
+
+	size_t size = static_cast<size_t>(info.st_size);
+	_text.resize(size + 1);
+	size_t done = 0;
+	while (done < size) {
+		ssize_t count = ::read(fd, _text.data() + done, size - done);
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count <= 0)
+			break;
+		done += count;
+	}
+	close(fd);
+	_text[done] = '\0';
+}
+
+/**
+ * @brief Parses the text buffer as rows of heights, dropping per-point colors.
+ *
+ * Blank lines are skipped; rows shorter than the grid are padded with zeros.
+ *
+ * @param grid Grid to fill, or NULL to set the grid size from the widest row
+ *        and the number of rows instead.
+ * @throws BadFrameException if a token does not start with a number, or the
+ *         frame does not fit the grid size.
+ */
+void FrameSequence::parseFrame(int *grid){
+	const char *cursor = _text.data();
+	int rows = 0;
+
+	while (*cursor) {
+		cursor = MapParser::parseHeights(cursor, _row);
+		if (!cursor)
+			throw (BadFrameException());
+		int columns = _row.size();
+		if (columns == 0)
+			continue;
+
+		if (grid) {
+			if (rows >= _height || columns > _width)
+				throw (BadFrameException());
+			int *out = grid + static_cast<size_t>(rows) * _width;
+			std::copy(_row.begin(), _row.end(), out);
+			std::fill(out + columns, out + _width, 0);
+		} else
+			_width = std::max(_width, columns);
+		rows++;
+	}
+
+	if (!grid)
+		_height = rows;
+	else if (rows != _height)
+		throw (BadFrameException());
+}
+
+/**
+ * @brief Smallest rectangle enclosing the cells that differ between two frames.
+ *
+ * @return The rectangle, empty (x0 == x1) if the frames are equal.
+ */
+FrameSequence::Region FrameSequence::changedRegion(const std::vector<int> &before, const std::vector<int> &after,
+	int width, int height){
+	Region region = {width, height, 0, 0};
+
+	for (int y = 0; y < height; y++) {
+		const int *a = before.data() + static_cast<size_t>(y) * width;
+		const int *b = after.data() + static_cast<size_t>(y) * width;
+		if (std::memcmp(a, b, width * sizeof(int)) == 0)
+			continue;
+
+		int first = 0;
+		while (a[first] == b[first])
+			first++;
+		int last = width;
+		while (a[last - 1] == b[last - 1])
+			last--;
+		region.x0 = std::min(region.x0, first);
+		region.x1 = std::max(region.x1, last);
+		region.y0 = std::min(region.y0, y);
+		region.y1 = y + 1;
+	}
+	if (region.x0 >= region.x1)
+		return (Region());
+	return (region);
+}
+
+const char *FrameSequence::BadSequenceException::what() const throw(){
+	return ("Bad frame sequence! (give a directory of .fdf frames or a glob pattern matching them)");
+}
+
+const char *FrameSequence::BadFrameException::what() const throw(){
+	return ("Bad sequence frame! (frames must be readable .fdf maps of the same grid size)");
+}
@@ -0,0 +1,340 @@
+/**
+# * @file HeightStream.cpp
+# * @brief Implements the HeightStream class for live height input.
+# *
+# * The reader thread polls its descriptor so it can be stopped while the writer is idle,
+# * parses each frame into the working grid and publishes a copy through the triple buffer.
+# */
+
+#include "../../includes/mapHandler/HeightStream.hpp"
+#include "../../includes/mapHandler/MapParser.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+static bool isBlank(const std::string &line) {
+	for (char c : line) {
+		if (!std::isspace(static_cast<unsigned char>(c)))
+			return (false);
+	}
+	return (true);
+}
+
+/**
+ * @brief Opens the stream and reads its first frame, which sets the grid size.
+ *
+ * Blocks until the first frame is complete; named pipes also block until a
+ * writer opens them. The reader thread starts once the first frame is published.
+ *
+ * @param path Named pipe or file to read, or "-" for stdin.
+ * @throws BadStreamException if the path cannot be opened.
+ * @throws BadFrameException if the stream ends or is malformed before a first frame.
+ */
+HeightStream::HeightStream(const std::string &path)
+	: _fd(-1), _ownsFd(path != "-"), _input(READ_CHUNK), _inputBegin(0), _inputEnd(0),
+	  _width(0), _height(0), _changed(), _back(0), _ready(1), _front(2), _fresh(false),
+	  _stop(false){
+	_fd = _ownsFd ? open(path.c_str(), O_RDONLY) : STDIN_FILENO;
+	if (_fd < 0)
+		throw (BadStreamException());
+
+	try {
+		if (!readFrame(true))
+			throw (BadFrameException());
+	} catch (...) {
+		if (_ownsFd)
+			close(_fd);
+		throw;
+	}
+	publish();
+
+	_reader = std::thread(&HeightStream::read, this);
+}
+
+/**
+ * @brief Stops the reader thread and closes the stream.
+ */
+HeightStream::~HeightStream(){
+	_stop = true;
+	if (_reader.joinable())
+		_reader.join();
+	if (_ownsFd)
+		close(_fd);
+}
+
+int HeightStream::getWidth() const{
+	return (_width);
+}
+
+int HeightStream::getHeight() const{
+	return (_height);
+}
+
+/**
+ * @brief Takes the latest published frame, if any arrived since the last call.
+ *
+ * Frames published in between are skipped, and their changes folded into the
+ * returned rectangle. The returned grid stays untouched until the next call.
+ *
+ * @param region Set to the cells changed since the previously acquired frame.
+ * @return getWidth() * getHeight() heights, row-major, or NULL if nothing new.
+ */
+const std::vector<int> *HeightStream::acquireFrame(Region &region){
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!_fresh)
+		return (NULL);
+	std::swap(_front, _ready);
+	_fresh = false;
+	region = _regions[_front];
+	return (&_buffers[_front]);
+}
+
+/**
+ * @brief Grows a rectangle to enclose another; empty rectangles are ignored.
+ */
+static void mergeRegion(HeightStream::Region &into, const HeightStream::Region &other){
+	if (other.x0 >= other.x1 || other.y0 >= other.y1)
+		return;
+	if (into.x0 >= into.x1 || into.y0 >= into.y1) {
+		into = other;
+		return;
+	}
+	into.x0 = std::min(into.x0, other.x0);
+	into.y0 = std::min(into.y0, other.y0);
+	into.x1 = std::max(into.x1, other.x1);
+	into.y1 = std::max(into.y1, other.y1);
+}
+
+/**
+ * @brief Copies the working grid into the back buffer and swaps it with the ready one.
+ *
+ * If the ready frame was never acquired, its changed rectangle is carried over,
+ * since the consumer will skip it.
+ */
+void HeightStream::publish(){
+	_buffers[_back] = _grid;
+	_regions[_back] = _changed;
+	_changed = Region();
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_fresh)
+		mergeRegion(_regions[_back], _regions[_ready]);
+	std::swap(_back, _ready);
+	_fresh = true;
+}
+
+/**
+ * @brief Reader thread body: publishes frames until the stream ends or is stopped.
+ */
+void HeightStream::read(){
+	try {
+		while (!_stop && readFrame(false))
+			publish();
+	} catch (const std::exception &e) {
+		std::cout << "Exception caught: " << e.what() << std::endl;
+	}
+}
+
+/**
+ * @brief Refills the input buffer once it is empty.
+ *
+ * Waits in POLL_TIMEOUT_MS steps so a stop request is noticed while the writer
+ * is idle.
+ *
+ * @return False at the end of the stream or when stopped.
+ */
+bool HeightStream::fill(){
+	if (_inputBegin < _inputEnd)
+		return (true);
+
+	struct pollfd request = {_fd, POLLIN, 0};
+	while (!_stop) {
+		int ready = poll(&request, 1, POLL_TIMEOUT_MS);
+		if (ready < 0 && errno != EINTR)
+			return (false);
+		if (ready <= 0)
+			continue;
+
+		ssize_t count = ::read(_fd, _input.data(), _input.size());
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count <= 0)
+			return (false);
+		_inputBegin = 0;
+		_inputEnd = count;
+		return (true);
+	}
+	return (false);
+}
+
+/**
+ * @brief Next input byte without consuming it, or -1 at the end of the stream.
+ */
+int HeightStream::peek(){
+	if (!fill())
+		return (-1);
+	return (static_cast<unsigned char>(_input[_inputBegin]));
+}
+
+/**
+ * @brief Reads one line without its line break.
+ * @return False if the stream ended before any character.
+ */
+bool HeightStream::readLine(std::string &line){
+	line.clear();
+	while (fill()) {
+		const char *begin = _input.data() + _inputBegin;
+		const char *newline = static_cast<const char *>(std::memchr(begin, '\n', _inputEnd - _inputBegin));
+		if (!newline) {
+			line.append(begin, _inputEnd - _inputBegin);
+			_inputBegin = _inputEnd;
+			continue;
+		}
+		line.append(begin, newline - begin);
+		_inputBegin += newline - begin + 1;
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		return (true);
+	}
+	return (!line.empty());
+}
+
+/**
+ * @brief Reads exactly size bytes.
+ * @return False if the stream ended first.
+ */
+bool HeightStream::readBytes(void *out, size_t size){
+	char *cursor = static_cast<char *>(out);
+	while (size > 0) {
+		if (!fill())
+			return (false);
+		size_t count = std::min(size, _inputEnd - _inputBegin);
+		std::memcpy(cursor, _input.data() + _inputBegin, count);
+		_inputBegin += count;
+		cursor += count;
+		size -= count;
+	}
+	return (true);
+}
+
+/**
+ * @brief Reads the next frame into the working grid, detecting its format.
+ *
+ * @param first Whether this frame sets the grid size.
+ * @return False at the end of the stream.
+ * @throws BadFrameException on malformed frames.
+ */
+bool HeightStream::readFrame(bool first){
+	int next;
+	while ((next = peek()) >= 0 && std::isspace(next))
+		_inputBegin++;
+	if (next < 0)
+		return (false);
+	return (next == 'F' ? readBinaryFrame(first) : readTextFrame(first));
+}
+
+/**
+ * @brief Reads a text frame; see the class description for the layout.
+ */
+bool HeightStream::readTextFrame(bool first){
+	std::string line;
+	if (!readLine(line))
+		return (false);
+
+	int x0 = 0;
+	int y0 = 0;
+	size_t marker = line.find_first_not_of(" \t");
+	if (line[marker] == '@') {
+		char *end;
+		x0 = std::strtol(line.c_str() + marker + 1, &end, 10);
+		y0 = std::strtol(end, &end, 10);
+		if (!isBlank(end))
+			throw (BadFrameException());
+		if (!readLine(line))
+			line.clear();
+	}
+
+	std::vector<std::vector<int>> rows;
+	while (!isBlank(line)) {
+		rows.push_back(std::vector<int>());
+		if (!MapParser::parseHeights(line.c_str(), rows.back()))
+			throw (BadFrameException());
+		if (!readLine(line))
+			break;
+	}
+
+	if (first) {
+		size_t width = 0;
+		for (const std::vector<int> &row : rows)
+			width = std::max(width, row.size());
+		if (x0 != 0 || y0 != 0 || width == 0)
+			throw (BadFrameException());
+		_width = width;
+		_height = rows.size();
+		_grid.assign(static_cast<size_t>(_width) * _height, 0);
+	}
+	for (size_t r = 0; r < rows.size(); r++)
+		applyRegion(x0, y0 + r, rows[r].size(), rows[r]);
+	return (true);
+}
+
+/**
+ * @brief Reads a binary frame; see BinaryHeader.
+ */
+bool HeightStream::readBinaryFrame(bool first){
+	BinaryHeader header;
+	if (!readBytes(&header, sizeof(header)))
+		return (false);
+	if (std::memcmp(header.magic, "FDFH", 4) != 0 || header.width <= 0 || header.height <= 0
+		|| static_cast<int64_t>(header.width) * header.height > (1 << 28))
+		throw (BadFrameException());
+
+	if (first) {
+		if (header.x != 0 || header.y != 0)
+			throw (BadFrameException());
+		_width = header.width;
+		_height = header.height;
+		_grid.assign(static_cast<size_t>(_width) * _height, 0);
+	}
+
+	std::vector<int> row(header.width);
+	for (int r = 0; r < header.height; r++) {
+		if (!readBytes(row.data(), row.size() * sizeof(int32_t)))
+			throw (BadFrameException());
+		applyRegion(header.x, header.y + r, header.width, row);
+	}
+	return (true);
+}
+
+/**
+ * @brief Writes one row of a frame into the working grid, clipped to the grid.
+ *
+ * @param x0 Grid column of the row's first value.
+ * @param y Grid row.
+ * @param width Number of values.
+ * @param values Row values.
+ */
+void HeightStream::applyRegion(int x0, int y, int width, const std::vector<int> &values){
+	if (y < 0 || y >= _height)
+		return;
+	int begin = std::max(0, -x0);
+	int end = std::min(width, _width - x0);
+	for (int i = begin; i < end; i++)
+		_grid[static_cast<size_t>(y) * _width + x0 + i] = values[i];
+	if (begin < end)
+		mergeRegion(_changed, {x0 + begin, y, x0 + end, y + 1});
+}
+
+const char *HeightStream::BadStreamException::what() const throw(){
+	return ("Bad height stream! (check existance and permissions)");
+}
+
+const char *HeightStream::BadFrameException::what() const throw(){
+	return ("Bad height frame! (rows of heights ended by a blank line, or FDFH binary frames)");
+}
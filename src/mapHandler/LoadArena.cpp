@@ -0,0 +1,72 @@
+/**
+# * @file LoadArena.cpp
+# * @brief Implements the LoadArena class, a bump allocator for map text.
+# *
+# * Allocations are carved from the end of the current block; a request that does not
+# * fit starts a new block, or gets a block of its own when it is larger than BLOCK_SIZE.
+# */
+
+#include "../../includes/mapHandler/LoadArena.hpp"
+#include <cstring>
+#include <utility>
+
+LoadArena::LoadArena() : _cursor(NULL), _left(0){}
+
+LoadArena::~LoadArena(){
+	release();
+}
+
+/**
+ * @brief Reserves uninitialized, unaligned bytes that live until release().
+ *
+ * @param size Number of bytes.
+ * @return Start of the bytes.
+ */
+char *LoadArena::allocate(size_t size){
+	if (size > _left) {
+		size_t blockSize = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+		char *block = new char[blockSize];
+		_blocks.push_back(block);
+		if (size > BLOCK_SIZE)
+			return (block);
+		_cursor = block;
+		_left = blockSize;
+	}
+	char *bytes = _cursor;
+	_cursor += size;
+	_left -= size;
+	return (bytes);
+}
+
+/**
+ * @brief Copies a piece of text into the arena, followed by a NUL.
+ *
+ * @return View of the copy, without the NUL.
+ */
+std::string_view LoadArena::copy(const char *text, size_t length){
+	char *bytes = allocate(length + 1);
+	std::memcpy(bytes, text, length);
+	bytes[length] = '\0';
+	return (std::string_view(bytes, length));
+}
+
+/**
+ * @brief Exchanges the blocks of two arenas, so text can change hands without copies.
+ */
+void LoadArena::swap(LoadArena &other){
+	std::swap(_blocks, other._blocks);
+	std::swap(_cursor, other._cursor);
+	std::swap(_left, other._left);
+}
+
+/**
+ * @brief Frees every block at once; views handed out before become invalid.
+ */
+void LoadArena::release(){
+	for (char *block : _blocks)
+		delete[] block;
+	_blocks.clear();
+	_blocks.shrink_to_fit();
+	_cursor = NULL;
+	_left = 0;
+}
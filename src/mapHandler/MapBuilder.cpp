@@ -8,6 +8,7 @@
 
 #include "../../includes/mapHandler/MapBuilder.hpp"
 #include <algorithm>
+#include <cstring>
 
 /**
  * @brief Constructs a MapBuilder object and loads the dictionary file.
@@ -29,42 +30,92 @@ MapBuilder::MapBuilder(std::string &input): _dicPath("dictionary/dictionary24.fd
  */
 MapBuilder::~MapBuilder(){}
 
-std::vector<std::string> &MapBuilder::getMap(){
+/**
+ * @brief Map rows, as views into the builder's arena.
+ */
+const std::vector<std::string_view> &MapBuilder::getMap() const{
     return (this->_map);
 }
 
+/**
+ * @brief Hands over the map rows with the arena holding them.
+ *
+ * The dictionary shares that arena, so the builder holds neither the rows nor
+ * the dictionary afterwards.
+ *
+ * @param text Arena receiving the text; anything it held before is freed.
+ * @return Rows, as views into text.
+ */
+std::vector<std::string_view> MapBuilder::takeMap(LoadArena &text){
+    for (std::string_view (&glyph)[GLYPH_ROWS] : this->_mapDictionary)
+        std::fill(glyph, glyph + GLYPH_ROWS, std::string_view());
+    text.swap(this->_arena);
+    this->_arena.release();
+    return (std::move(this->_map));
+}
+
 /**
  * @brief Loads the character dictionary from the dictionary file.
+ *
+ * The file is read into the arena in one piece, and each glyph row is a view
+ * into it; rows of characters missing from the dictionary stay null views.
+ *
  * @throws BadDicFileException if the file cannot be read.
  */
 void MapBuilder::feedDictionary() {
-    std::ifstream dicFile(this->_dicPath.c_str());
+    std::ifstream dicFile(this->_dicPath.c_str(), std::ios::binary);
     
     if (dicFile.fail() || dicFile.bad()) {
         throw (BadDicFileException());
     }
 
-    std::string line;
-    while (std::getline(dicFile, line)) {
+    std::streamoff size = dicFile.seekg(0, std::ios::end).tellg();
+    dicFile.seekg(0);
+    if (size < 0)
+        throw (BadDicFileException());
+    char *text = this->_arena.allocate(static_cast<size_t>(size));
+    dicFile.read(text, size);
+    std::string_view rest(text, static_cast<size_t>(dicFile.gcount()));
+    dicFile.close();
+
+    auto nextLine = [&rest](std::string_view &line) {
+        if (rest.empty())
+            return (false);
+        size_t end = std::min(rest.find('\n'), rest.size());
+        line = rest.substr(0, end);
+        rest.remove_prefix(std::min(end + 1, rest.size()));
+        return (true);
+    };
+
+    std::string_view line;
+    while (nextLine(line)) {
         if (line.size() >= 2 && line[0] == '~') {
-            char c = line[1];
-            
-            std::vector<std::string> charLines;
-            for (int j = 0; j < 24; j++) {
-                if (!std::getline(dicFile, line)) {
+            std::string_view *glyph = this->_mapDictionary[static_cast<unsigned char>(line[1])];
+            for (int j = 0; j < GLYPH_ROWS; j++) {
+                if (!nextLine(glyph[j])) {
                     throw BadDicFileException();
                 }
-                charLines.push_back(line);
             }
-            
-            this->_mapDictionary[static_cast<int>(c)] = charLines;
         }
     }
-    dicFile.close();
+}
+
+/**
+ * @brief One row of a character's glyph, or blanks if the dictionary lacks it.
+ */
+std::string_view MapBuilder::glyphRow(char c, int row) const{
+    const std::string_view *glyph = this->_mapDictionary[static_cast<unsigned char>(c)];
+    if (glyph[0].data() == NULL)
+        return ("          ");
+    return (glyph[row]);
 }
 
 /**
  * @brief Builds the map from an input string using the character dictionary.
+ *
+ * Each row's length is summed from its glyph rows first, so it is written
+ * into the arena in one exact allocation.
+ *
  * @param str Input string to convert to map.
  * @throws StringTooLongException if the string is too long.
  */
@@ -73,22 +124,23 @@ void MapBuilder::buildMapFromString(std::string &str){
 
     std::transform(str.begin(), str.end(), str.begin(), ::toupper);
 
-    for (int i = 0; i < 24; i++) {
-        std::string row;
-        for (size_t j = 0; j < str.length(); j++) {
-            char c = str.at(j);
-            
-            int charIdx = static_cast<int>(c);
-            
-            if (this->_mapDictionary.find(charIdx) != this->_mapDictionary.end() && 
-                !this->_mapDictionary[charIdx].empty()) {
-                row += this->_mapDictionary[charIdx].at(i);
-            } else {
-                row += "          ";
-            }
-            row += "  ";
+    this->_map.reserve(GLYPH_ROWS);
+    for (int i = 0; i < GLYPH_ROWS; i++) {
+        size_t length = 0;
+        for (char c : str)
+            length += glyphRow(c, i).size() + 2;
+
+        char *row = this->_arena.allocate(length + 1);
+        char *out = row;
+        for (char c : str) {
+            std::string_view glyph = glyphRow(c, i);
+            std::memcpy(out, glyph.data(), glyph.size());
+            out += glyph.size();
+            *out++ = ' ';
+            *out++ = ' ';
         }
-        this->_map.push_back(row);
+        *out = '\0';
+        this->_map.push_back(std::string_view(row, length));
     }
 }
 
@@ -107,7 +159,7 @@ void MapBuilder::buildMapFromPath(std::string &str){
 
     std::string line;
     while (std::getline(mapFile, line)){
-        this->_map.push_back(line);
+        this->_map.push_back(this->_arena.copy(line.data(), line.size()));
     }
     mapFile.close();
 }
@@ -140,7 +192,7 @@ bool MapBuilder::checkInputType(std::string &input){
  * @brief Prints the map data to standard output.
  */
 void MapBuilder::mapPrinter(){
-    for (std::vector<std::string>::iterator it = this->_map.begin(); it != this->_map.end(); it++)
+    for (std::vector<std::string_view>::iterator it = this->_map.begin(); it != this->_map.end(); it++)
         std::cout << *it <<  std::endl;
 }
 
@@ -148,7 +200,10 @@ void MapBuilder::mapPrinter(){
  * @brief Prints the size of the loaded dictionary to standard output.
  */
 void MapBuilder::dictionaryPrinter(){
-    std::cout << "dictionary size is:" << _mapDictionary.size() << std::endl;
+    size_t size = 0;
+    for (const std::string_view (&glyph)[GLYPH_ROWS] : _mapDictionary)
+        size += glyph[0].data() != NULL;
+    std::cout << "dictionary size is:" << size << std::endl;
 }
 
 const char *MapBuilder::BadDicFileException::what() const throw(){
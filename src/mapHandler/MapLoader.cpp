@@ -0,0 +1,192 @@
+/**
+# * @file MapLoader.cpp
+# * @brief Implements the MapLoader class for streaming map files in the background.
+# *
+# * A reader thread copies the file's lines into its arena and appends them in batches
+# * under a mutex, so previews can be cut from the rows read so far at any time without
+# * stalling the reader for long.
+# */
+
+#include "../../includes/mapHandler/MapLoader.hpp"
+#include "../../includes/mapHandler/MapBuilder.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iterator>
+
+/**
+ * @brief Finds the next whitespace-separated point of a map row.
+ *
+ * @param row Row being split.
+ * @param start Offset to search from; moved past the point found.
+ * @return The point, or an empty view once the row is exhausted.
+ */
+static std::string_view nextPoint(std::string_view row, size_t &start) {
+	while (start < row.size() && std::isspace(static_cast<unsigned char>(row[start])))
+		start++;
+	size_t end = start;
+	while (end < row.size() && !std::isspace(static_cast<unsigned char>(row[end])))
+		end++;
+	std::string_view point = row.substr(start, end - start);
+	start = end;
+	return (point);
+}
+
+/**
+ * @brief Opens a map file and starts reading it on a background thread.
+ * @param path Path to the map file.
+ * @throws MapBuilder::BadMapFileException if the file cannot be opened.
+ */
+MapLoader::MapLoader(const std::string &path)
+	: _file(path.c_str(), std::ios::binary), _fileSize(0), _bytesRead(0),
+	  _done(false), _stop(false), _columns(0){
+	if (_file.fail() || _file.bad())
+		throw (MapBuilder::BadMapFileException());
+
+	// Pipes have no size; previews then only cover the rows read so far.
+	std::streampos end = _file.seekg(0, std::ios::end).tellg();
+	_file.clear();
+	if (end > 0) {
+		_fileSize = static_cast<size_t>(end);
+		_file.seekg(0);
+	}
+
+	_reader = std::thread(&MapLoader::read, this);
+}
+
+/**
+ * @brief Stops the reader thread, if still running, and closes the file.
+ */
+MapLoader::~MapLoader(){
+	_stop = true;
+	if (_reader.joinable())
+		_reader.join();
+}
+
+/**
+ * @brief Reader thread body: appends the file's lines in batches of BATCH_ROWS.
+ *
+ * Each line is read into the same buffer and copied into the arena, so the
+ * rows cost their length plus a NUL, with no per-row heap allocation.
+ */
+void MapLoader::read(){
+	std::vector<std::string_view> batch;
+	std::string line;
+	bool more = true;
+
+	while (more && !_stop) {
+		batch.clear();
+		size_t bytes = 0;
+		while (batch.size() < BATCH_ROWS && (more = static_cast<bool>(std::getline(_file, line)))) {
+			bytes += line.size() + 1;
+			batch.push_back(_arena.copy(line.data(), line.size()));
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_columns == 0 && _rows.empty() && !batch.empty()) {
+			size_t start = 0;
+			while (!nextPoint(batch[0], start).empty())
+				_columns++;
+		}
+		std::move(batch.begin(), batch.end(), std::back_inserter(_rows));
+		_bytesRead += bytes;
+		_progress.notify_all();
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_done = true;
+	_progress.notify_all();
+}
+
+bool MapLoader::isDone() const{
+	return (_done);
+}
+
+size_t MapLoader::getRowCount() const{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return (_rows.size());
+}
+
+/**
+ * @brief Blocks until the whole file is read or the timeout expires.
+ * @return True if the file has been read completely.
+ */
+bool MapLoader::waitUntilDone(std::chrono::milliseconds timeout) const{
+	std::unique_lock<std::mutex> lock(_mutex);
+	return (_progress.wait_for(lock, timeout, [this] { return (_done.load()); }));
+}
+
+/**
+ * @brief Estimates the points of the whole map from the rows read so far.
+ *
+ * Assumes the rest of the file has the same bytes per row. Expects the mutex held.
+ */
+double MapLoader::estimatePoints() const{
+	double expectedRows = _rows.size();
+	if (!_done && _bytesRead > 0 && _fileSize > 0)
+		expectedRows *= static_cast<double>(_fileSize) / _bytesRead;
+	return (expectedRows * std::max<size_t>(_columns, 1));
+}
+
+/**
+ * @brief Estimated number of points of the whole map; see estimatePoints().
+ */
+size_t MapLoader::getExpectedPoints() const{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return (static_cast<size_t>(estimatePoints()));
+}
+
+/**
+ * @brief Builds a subsampled copy of the rows read so far.
+ *
+ * The step between kept rows and columns is chosen from the estimated size of the
+ * whole file, so successive previews share the same density and the last one has
+ * about maxPoints points. Blocks until at least one row is available.
+ *
+ * @param arena Arena receiving the preview's text.
+ * @param maxPoints Point budget of a preview of the complete map.
+ * @return Preview rows, in the same text format as the map file.
+ */
+std::vector<std::string_view> MapLoader::getPreview(LoadArena &arena, size_t maxPoints) const{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_progress.wait(lock, [this] { return (_done || !_rows.empty()); });
+
+	double expectedPoints = estimatePoints();
+	size_t step = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(expectedPoints / maxPoints))));
+
+	std::vector<std::string_view> preview;
+	preview.reserve((_rows.size() + step - 1) / step);
+	std::string row;
+	for (size_t y = 0; y < _rows.size(); y += step) {
+		row.clear();
+		size_t start = 0;
+		for (size_t x = 0; ; x++) {
+			std::string_view point = nextPoint(_rows[y], start);
+			if (point.empty())
+				break;
+			if (x % step == 0) {
+				row += point;
+				row += ' ';
+			}
+		}
+		preview.push_back(arena.copy(row.data(), row.size()));
+	}
+	return (preview);
+}
+
+/**
+ * @brief Waits for the reader to finish and hands over every row of the file.
+ *
+ * The loader holds no rows afterwards.
+ *
+ * @param text Arena receiving the rows' text; anything it held before is freed.
+ * @return Rows, as views into text.
+ */
+std::vector<std::string_view> MapLoader::takeRows(LoadArena &text){
+	if (_reader.joinable())
+		_reader.join();
+	std::lock_guard<std::mutex> lock(_mutex);
+	text.swap(_arena);
+	_arena.release();
+	return (std::move(_rows));
+}
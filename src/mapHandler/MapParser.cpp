@@ -7,6 +7,10 @@
 # */
 
 #include "../../includes/mapHandler/MapParser.hpp"
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 
 /**
  * @brief Constructs a MapParser object for validating a map matrix.
@@ -33,6 +37,41 @@ bool MapParser::parseMap(){
 	return (true);
 }
 
+/**
+ * @brief Parses the heights of one .fdf row, dropping per-point colors.
+ *
+ * The row ends at a newline or at the end of the text, so the same call reads
+ * single lines and whole files.
+ *
+ * @param cursor Start of the row, in NUL-terminated text.
+ * @param row Cleared, then filled with the row's heights.
+ * @return Past the row and its newline, or NULL if a token does not start with a
+ *         number or its height does not fit in an int.
+ */
+const char *MapParser::parseHeights(const char *cursor, std::vector<int> &row){
+	row.clear();
+	while (true){
+		while (*cursor != '\n' && std::isspace(static_cast<unsigned char>(*cursor)))
+			cursor++;
+		if (!*cursor || *cursor == '\n')
+			break;
+
+		char *end;
+		errno = 0;
+		long z = std::strtol(cursor, &end, 10);
+		if (end == cursor || errno == ERANGE || z < INT_MIN || z > INT_MAX)
+			return (NULL);
+		row.push_back(static_cast<int>(z));
+
+		cursor = end;
+		while (*cursor && !std::isspace(static_cast<unsigned char>(*cursor)))
+			cursor++;
+	}
+	if (*cursor == '\n')
+		cursor++;
+	return (cursor);
+}
+
 /**
  * @brief Exception message for bad map format errors.
  * @return Error message string.
@@ -0,0 +1,462 @@
+/**
+# * @file TiledMap.cpp
+# * @brief Implements the TiledMap class for out-of-core, memory-mapped height maps.
+# *
+# * Converts .fdf text maps into the tiled .fdft layout one band of rows at a time, maps
+# * .fdft files read-only and keeps the tiles the renderer asks for resident within a
+# * memory budget, advising the kernel to drop the least recently used ones.
+# */
+
+#include "../../includes/mapHandler/TiledMap.hpp"
+#include "../../includes/mapHandler/MapParser.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Byte offset, from the start of the file, of a level's sample at (x, y).
+ *
+ * Vertices on a tile border are read from the tile they start.
+ */
+static size_t sampleOffset(const TiledMap::Level &level, const TiledMap::Tile *tiles, int tileSize, int x, int y) {
+	int tx = std::min<int>(x / tileSize, level.tilesX - 1);
+	int ty = std::min<int>(y / tileSize, level.tilesY - 1);
+	const TiledMap::Tile &tile = tiles[level.firstTile + static_cast<uint64_t>(ty) * level.tilesX + tx];
+	return tile.offset + (static_cast<size_t>(y - ty * tileSize) * (tileSize + 1) + (x - tx * tileSize)) * sizeof(int32_t);
+}
+
+static size_t alignUp(size_t value, size_t alignment) {
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Checks a mapped file against the layout convert() writes.
+ *
+ * Each level must follow from the header's grid and tile size exactly as the
+ * writer derives it, and the tile table and every tile must lie inside the
+ * file, so readers can index tiles without further checks. Sizes are compared
+ * as byte counts before any pointer past the header is formed.
+ *
+ * @param data Start of the mapping, at least sizeof(Header) bytes long.
+ * @param size Size of the mapping in bytes.
+ * @return True if the file is a valid tiled map.
+ */
+static bool isValidLayout(const uint8_t *data, size_t size) {
+	const TiledMap::Header &header = *reinterpret_cast<const TiledMap::Header *>(data);
+	if (std::memcmp(header.magic, "FDFT", 4) != 0 || header.version != TiledMap::VERSION ||
+		header.tileSize < 1 || header.tileSize > TiledMap::MAX_TILE_SIZE ||
+		header.width < 1 || header.width > INT_MAX || header.height < 1 || header.height > INT_MAX ||
+		header.levelCount < 1)
+		return false;
+
+	uint64_t tableBytes = sizeof(TiledMap::Header) + static_cast<uint64_t>(header.levelCount) * sizeof(TiledMap::Level);
+	if (tableBytes > size)
+		return false;
+	uint64_t maxTiles = (size - tableBytes) / sizeof(TiledMap::Tile);
+
+	const TiledMap::Level *levels = reinterpret_cast<const TiledMap::Level *>(data + sizeof(TiledMap::Header));
+	uint64_t tileSize = header.tileSize;
+	uint64_t width = header.width;
+	uint64_t height = header.height;
+	uint64_t tileCount = 0;
+	for (uint32_t l = 0; l < header.levelCount; l++, width = (width + 1) / 2, height = (height + 1) / 2) {
+		const TiledMap::Level &level = levels[l];
+		uint64_t tilesX = std::max<uint64_t>(1, (width - 1 + tileSize - 1) / tileSize);
+		uint64_t tilesY = std::max<uint64_t>(1, (height - 1 + tileSize - 1) / tileSize);
+		bool last = l + 1 == header.levelCount;
+		if (level.width != width || level.height != height || level.tilesX != tilesX || level.tilesY != tilesY ||
+			level.firstTile != tileCount || (tilesX == 1 && tilesY == 1) != last ||
+			tilesX * tilesY > maxTiles - tileCount)
+			return false;
+		tileCount += tilesX * tilesY;
+	}
+
+	const TiledMap::Tile *tiles = reinterpret_cast<const TiledMap::Tile *>(data + tableBytes);
+	size_t tileBytes = (tileSize + 1) * (tileSize + 1) * sizeof(int32_t);
+	for (uint64_t i = 0; i < tileCount; i++) {
+		if (tiles[i].offset % sizeof(int32_t) != 0 || tiles[i].offset > size || size - tiles[i].offset < tileBytes)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Maps a .fdft file and validates its header and tile table.
+ * @param path Path to the .fdft file.
+ * @param memoryBudget Bytes of tile data kept resident by acquireTile().
+ * @throws BadTiledFileException if the file cannot be opened or mapped.
+ * @throws BadTiledFormatException if the file is not a valid tiled map.
+ */
+TiledMap::TiledMap(const std::string &path, size_t memoryBudget)
+	: _fd(-1), _data(NULL), _size(0), _header(NULL), _levels(NULL), _tiles(NULL),
+	  _tileBytes(0), _memoryBudget(memoryBudget) {
+	_fd = open(path.c_str(), O_RDONLY);
+	if (_fd < 0)
+		throw (BadTiledFileException());
+
+	struct stat info;
+	if (fstat(_fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+		close(_fd);
+		throw (BadTiledFormatException());
+	}
+	_size = info.st_size;
+
+	void *mapping = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+	if (mapping == MAP_FAILED) {
+		close(_fd);
+		throw (BadTiledFileException());
+	}
+	_data = static_cast<const uint8_t *>(mapping);
+	_header = reinterpret_cast<const Header *>(_data);
+
+	bool valid = isValidLayout(_data, _size);
+	if (valid) {
+		_levels = reinterpret_cast<const Level *>(_data + sizeof(Header));
+		_tiles = reinterpret_cast<const Tile *>(_levels + _header->levelCount);
+		_tileBytes = static_cast<size_t>(_header->tileSize + 1) * (_header->tileSize + 1) * sizeof(int32_t);
+	}
+	if (!valid) {
+		munmap(mapping, _size);
+		close(_fd);
+		throw (BadTiledFormatException());
+	}
+}
+
+/**
+ * @brief Unmaps the file and closes it.
+ */
+TiledMap::~TiledMap() {
+	munmap(const_cast<uint8_t *>(_data), _size);
+	close(_fd);
+}
+
+/**
+ * @brief Tells whether a map argument names a tiled map.
+ * @param path Map argument as given on the command line.
+ * @return True for paths ending in .fdft.
+ */
+bool TiledMap::isTiledPath(const std::string &path) {
+	std::string suffix = ".fdft";
+	return path.length() > suffix.length() &&
+		   path.compare(path.length() - suffix.length(), suffix.length(), suffix) == 0;
+}
+
+/**
+ * @brief Converts a .fdf text map into a tiled .fdft file.
+ *
+ * A first pass only measures the grid, which fixes the whole file layout. The output is
+ * then mapped and level 0 is filled one band of tileSize + 1 rows at a time, so the text
+ * map is never held in memory; each coarser level is sampled from the previous one
+ * inside the mapping. Per-point colors are not kept.
+ *
+ * @param input Path to the .fdf map.
+ * @param output Path of the .fdft file to write.
+ * @param noDataValue Optional height excluded from the tile height ranges.
+ * @param tileSize Vertices per tile side, excluding the shared border, at most MAX_TILE_SIZE.
+ * @throws BadTiledFileException if either file cannot be opened or written.
+ * @throws BadTiledFormatException if the input is empty or not a height map, or
+ *         tileSize is out of range.
+ *         Once the output has been created, a failure removes it again rather than
+ *         leaving a truncated file behind.
+ */
+void TiledMap::convert(const std::string &input, const std::string &output,
+					   std::optional<int> noDataValue, int tileSize) {
+	std::ifstream mapFile(input.c_str());
+	if (mapFile.fail() || mapFile.bad())
+		throw (BadTiledFileException());
+
+	std::string line;
+	std::vector<int> row;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	while (std::getline(mapFile, line)) {
+		if (line.empty())
+			continue;
+		if (!MapParser::parseHeights(line.c_str(), row))
+			throw (BadTiledFormatException());
+		width = std::max<uint32_t>(width, row.size());
+		height++;
+	}
+	if (width == 0 || height == 0 || width > INT_MAX || height > INT_MAX ||
+		tileSize < 1 || static_cast<uint32_t>(tileSize) > MAX_TILE_SIZE)
+		throw (BadTiledFormatException());
+
+	std::vector<Level> levels;
+	uint64_t tileCount = 0;
+	for (uint32_t w = width, h = height; ; w = (w + 1) / 2, h = (h + 1) / 2) {
+		Level level;
+		level.width = w;
+		level.height = h;
+		level.tilesX = std::max<uint32_t>(1, (w - 1 + tileSize - 1) / tileSize);
+		level.tilesY = std::max<uint32_t>(1, (h - 1 + tileSize - 1) / tileSize);
+		level.firstTile = tileCount;
+		tileCount += static_cast<uint64_t>(level.tilesX) * level.tilesY;
+		levels.push_back(level);
+		if (level.tilesX == 1 && level.tilesY == 1)
+			break;
+	}
+
+	size_t tileBytes = static_cast<size_t>(tileSize + 1) * (tileSize + 1) * sizeof(int32_t);
+	size_t tileStride = alignUp(tileBytes, TILE_ALIGNMENT);
+	size_t tableBytes = sizeof(Header) + levels.size() * sizeof(Level) + tileCount * sizeof(Tile);
+	size_t payload = alignUp(tableBytes, TILE_ALIGNMENT);
+	size_t size = payload + tileCount * tileStride;
+
+	int fd = open(output.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		throw (BadTiledFileException());
+	void *mapping = MAP_FAILED;
+	if (ftruncate(fd, size) == 0)
+		mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (mapping == MAP_FAILED) {
+		close(fd);
+		unlink(output.c_str());
+		throw (BadTiledFileException());
+	}
+
+	uint8_t *data = static_cast<uint8_t *>(mapping);
+	Header *header = reinterpret_cast<Header *>(data);
+	Level *levelTable = reinterpret_cast<Level *>(data + sizeof(Header));
+	Tile *tiles = reinterpret_cast<Tile *>(levelTable + levels.size());
+
+	std::copy(levels.begin(), levels.end(), levelTable);
+	for (uint64_t i = 0; i < tileCount; i++)
+		tiles[i].offset = payload + i * tileStride;
+
+	int32_t minHeight = INT_MAX;
+	int32_t maxHeight = INT_MIN;
+
+	// Fills one tile from a sampler and records its height range; true if it holds data.
+	auto writeTile = [&](size_t l, uint32_t tx, uint32_t ty, auto sample) {
+		const Level &level = levels[l];
+		Tile &tile = tiles[level.firstTile + static_cast<uint64_t>(ty) * level.tilesX + tx];
+		int32_t *out = reinterpret_cast<int32_t *>(data + tile.offset);
+
+		tile.minZ = INT_MAX;
+		tile.maxZ = INT_MIN;
+		for (int sy = 0; sy <= tileSize; sy++) {
+			uint32_t y = std::min<uint32_t>(ty * tileSize + sy, level.height - 1);
+			for (int sx = 0; sx <= tileSize; sx++) {
+				uint32_t x = std::min<uint32_t>(tx * tileSize + sx, level.width - 1);
+				int32_t z = sample(x, y);
+				*out++ = z;
+				if (noDataValue && z == *noDataValue)
+					continue;
+				tile.minZ = std::min(tile.minZ, z);
+				tile.maxZ = std::max(tile.maxZ, z);
+			}
+		}
+		if (tile.minZ > tile.maxZ) {
+			tile.minZ = 0;
+			tile.maxZ = 0;
+			return false;
+		}
+		return true;
+	};
+
+	try {
+		mapFile.clear();
+		mapFile.seekg(0);
+
+		std::vector<std::vector<int>> band;
+		for (uint32_t ty = 0; ty < levels[0].tilesY; ty++) {
+			uint32_t first = ty * tileSize;
+			uint32_t last = std::min<uint32_t>(first + tileSize, height - 1);
+
+			while (band.size() < last - first + 1) {
+				std::vector<int> next(width, 0);
+				while (std::getline(mapFile, line)) {
+					if (line.empty())
+						continue;
+					if (!MapParser::parseHeights(line.c_str(), row))
+						throw (BadTiledFormatException());
+					std::copy(row.begin(), row.end(), next.begin());
+					break;
+				}
+				band.push_back(next);
+			}
+
+			for (uint32_t tx = 0; tx < levels[0].tilesX; tx++) {
+				const Tile &tile = tiles[static_cast<uint64_t>(ty) * levels[0].tilesX + tx];
+				if (writeTile(0, tx, ty, [&](uint32_t x, uint32_t y) { return band[y - first][x]; })) {
+					minHeight = std::min(minHeight, tile.minZ);
+					maxHeight = std::max(maxHeight, tile.maxZ);
+				}
+			}
+			band.erase(band.begin(), band.end() - 1);
+		}
+
+		for (size_t l = 1; l < levels.size(); l++) {
+			const Level &finer = levels[l - 1];
+			for (uint32_t ty = 0; ty < levels[l].tilesY; ty++) {
+				for (uint32_t tx = 0; tx < levels[l].tilesX; tx++) {
+					writeTile(l, tx, ty, [&](uint32_t x, uint32_t y) {
+						return *reinterpret_cast<int32_t *>(data + sampleOffset(finer, tiles, tileSize, 2 * x, 2 * y));
+					});
+				}
+			}
+		}
+	} catch (...) {
+		munmap(mapping, size);
+		close(fd);
+		unlink(output.c_str());
+		throw;
+	}
+
+	if (minHeight > maxHeight) {
+		minHeight = 0;
+		maxHeight = 0;
+	}
+	std::memcpy(header->magic, "FDFT", 4);
+	header->version = VERSION;
+	header->width = width;
+	header->height = height;
+	header->tileSize = tileSize;
+	header->levelCount = levels.size();
+	header->hasNoData = noDataValue.has_value();
+	header->noDataValue = noDataValue.value_or(0);
+	header->minHeight = minHeight;
+	header->maxHeight = maxHeight;
+
+	munmap(mapping, size);
+	close(fd);
+}
+
+int TiledMap::getWidth() const {
+	return _header->width;
+}
+
+int TiledMap::getHeight() const {
+	return _header->height;
+}
+
+int TiledMap::getTileSize() const {
+	return _header->tileSize;
+}
+
+int TiledMap::getLevelCount() const {
+	return _header->levelCount;
+}
+
+/**
+ * @brief Returns the no-data height recorded at conversion, if any.
+ */
+std::optional<int> TiledMap::getNoDataValue() const {
+	if (!_header->hasNoData)
+		return std::nullopt;
+	return _header->noDataValue;
+}
+
+const TiledMap::Level &TiledMap::getLevel(int level) const {
+	return _levels[level];
+}
+
+/**
+ * @brief Returns the table entry of a tile, without paging its samples in.
+ */
+const TiledMap::Tile &TiledMap::getTile(int level, int tx, int ty) const {
+	return _tiles[_levels[level].firstTile + static_cast<uint64_t>(ty) * _levels[level].tilesX + tx];
+}
+
+/**
+ * @brief Picks the finest level small enough to be loaded whole.
+ * @param maxPoints Largest acceptable vertex count.
+ * @return Index of the level, or the coarsest one if none is small enough.
+ */
+int TiledMap::getOverviewLevel(size_t maxPoints) const {
+	for (uint32_t level = 0; level < _header->levelCount; level++) {
+		if (static_cast<size_t>(_levels[level].width) * _levels[level].height <= maxPoints)
+			return level;
+	}
+	return _header->levelCount - 1;
+}
+
+/**
+ * @brief Copies a whole level out of the file, row-major.
+ *
+ * Meant for the overview level. The pages read are released afterwards, so the copy
+ * does not count against the tile cache.
+ *
+ * @param level Level to read.
+ * @return width * height heights of the level.
+ */
+std::vector<int> TiledMap::readLevel(int level) const {
+	const Level &info = _levels[level];
+	int tileSize = _header->tileSize;
+	std::vector<int> heights(static_cast<size_t>(info.width) * info.height);
+
+	for (uint32_t y = 0; y < info.height; y++) {
+		for (uint32_t x = 0; x < info.width; x++)
+			heights[static_cast<size_t>(y) * info.width + x] =
+				*reinterpret_cast<const int32_t *>(_data + sampleOffset(info, _tiles, tileSize, x, y));
+	}
+
+	uint64_t tileEnd = info.firstTile + static_cast<uint64_t>(info.tilesX) * info.tilesY;
+	for (uint64_t tile = info.firstTile; tile < tileEnd; tile++) {
+		if (_resident.find(tile) == _resident.end())
+			advise(tile, MADV_DONTNEED);
+	}
+	return heights;
+}
+
+/**
+ * @brief Returns the samples of a tile, paging it in if needed.
+ *
+ * The tile becomes the most recently used one. When the resident tiles exceed the
+ * memory budget, the least recently used ones are released back to the kernel. The
+ * returned pointer stays valid after eviction, which only costs a re-read from disk.
+ *
+ * @param level Detail level of the tile.
+ * @param tx Tile column.
+ * @param ty Tile row.
+ * @return (tileSize + 1)^2 samples, row-major.
+ */
+const int32_t *TiledMap::acquireTile(int level, int tx, int ty) {
+	uint64_t tile = _levels[level].firstTile + static_cast<uint64_t>(ty) * _levels[level].tilesX + tx;
+
+	std::unordered_map<uint64_t, std::list<uint64_t>::iterator>::iterator it = _resident.find(tile);
+	if (it != _resident.end()) {
+		_recent.splice(_recent.begin(), _recent, it->second);
+	} else {
+		advise(tile, MADV_WILLNEED);
+		_recent.push_front(tile);
+		_resident[tile] = _recent.begin();
+
+		while (_resident.size() > 1 && _resident.size() * _tileBytes > _memoryBudget) {
+			uint64_t victim = _recent.back();
+			advise(victim, MADV_DONTNEED);
+			_resident.erase(victim);
+			_recent.pop_back();
+		}
+	}
+	return reinterpret_cast<const int32_t *>(_data + _tiles[tile].offset);
+}
+
+/**
+ * @brief Passes paging advice for the pages spanned by a tile.
+ *
+ * Rounds outward to whole pages; with pages larger than TILE_ALIGNMENT a neighbor
+ * may be affected too, which only costs a re-read.
+ */
+void TiledMap::advise(uint64_t tile, int advice) const {
+	static const size_t pageSize = sysconf(_SC_PAGESIZE);
+
+	uintptr_t begin = reinterpret_cast<uintptr_t>(_data + _tiles[tile].offset);
+	uintptr_t end = begin + _tileBytes;
+	begin = begin / pageSize * pageSize;
+	end = alignUp(end, pageSize);
+	madvise(reinterpret_cast<void *>(begin), end - begin, advice);
+}
+
+const char *TiledMap::BadTiledFileException::what() const throw(){
+	return ("Bad tiled map file! (check existence and permissions)");
+}
+
+const char *TiledMap::BadTiledFormatException::what() const throw(){
+	return ("Bad tiled map format! (convert .fdf maps with --tile)");
+}
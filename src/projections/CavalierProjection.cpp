@@ -10,22 +10,3 @@
 #include "../../includes/projections/CavalierProjection.hpp"
 
 CavalierProjection::~CavalierProjection(){}
-
-/**
- * @brief Projects 3D coordinates to 2D using cavalier projection.
- * 
- * Applies cavalier projection with a 45-degree angle and full scaling (factor = 1.0)
- * for the depth dimension. This preserves the true length of receding edges but
- * may appear more distorted than cabinet projection.
- * 
- * @param x X coordinate in 3D space.
- * @param y Y coordinate in 3D space.
- * @param z Z coordinate (depth) in 3D space.
- * @return A pair containing the cavalier-projected 2D screen coordinates.
- */
-std::pair<int, int> CavalierProjection::project(int &x, int &y, int &z) const {
-    double angle = M_PI / 4;
-    int newX = x + z * cos(angle);
-    int newY = y - z * sin(angle);
-    return {newX, newY};
-}
\ No newline at end of file
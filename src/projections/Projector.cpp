@@ -10,50 +10,52 @@
 #include "../../includes/projections/Projector.hpp"
 
 /**
- * @brief Constructs a Projector object and initializes all available projection types.
+ * @brief Constructs a Projector object with no projection selected yet.
  * 
- * Creates instances of all supported projection algorithms and sets up the projection
- * management system. Each projection type is instantiated and ready for use.
+ * Projections are small value types held in a variant, so nothing is allocated;
+ * call setType() before projecting.
  */
-Projector::Projector(){
-	_isometric = new IsometricProjection();
-	_perspective = new PerspectiveProjection();
-	_orthographic = new OrthographicProjection();
-	_trimetric = new TrimetricProjection();
-	_dimetric = new DimetricProjection();
-	_cabinet = new CabinetProjection();
-	_cavalier = new CavalierProjection();
-	_military = new MilitaryProjection();
-	_recursive = new RecursiveDepth();
-	_hyperbolic = new HyperbolicProjection();
-	_conic = new ConicProjection();
-	_spherical = new SphericalConicProjection();
-}
+Projector::Projector() : _type(0){}
 
 /**
  * @brief Destructor for the Projector class.
- * 
- * Properly deallocates memory for all projection instances to prevent memory leaks.
  */
-Projector::~Projector(){
-	delete _isometric;
-    delete _perspective;
-    delete _orthographic;
-    delete _trimetric;
-    delete _dimetric;
-    delete _cabinet;
-    delete _cavalier;
-    delete _military;
-    delete _recursive;
-	delete _hyperbolic;
-	delete _conic;
-	delete _spherical;
-}
+Projector::~Projector(){}
 
-IProjection *Projector::getProjection(){
+const Projection &Projector::getProjection() const{
 	return (_selectedProjection);
 }
 
+int Projector::getType() const{
+	return (_type);
+}
+
+/**
+ * @brief Returns whether the active projection is a linear map.
+ */
+bool Projector::isAffine() const{
+	return (std::visit([](const auto &projection){
+		return (std::decay_t<decltype(projection)>::IS_AFFINE);
+	}, _selectedProjection));
+}
+
+/**
+ * @brief Projects a single point with the active projection.
+ * 
+ * Dispatches through std::visit on every call; loops over many points should
+ * visit the variant once instead and call project() on the concrete type.
+ * 
+ * @param x X coordinate in 3D space.
+ * @param y Y coordinate in 3D space.
+ * @param z Z coordinate (height) in 3D space.
+ * @return The projected 2D coordinates.
+ */
+std::pair<int, int> Projector::project(int x, int y, int z) const{
+	return (std::visit([x, y, z](const auto &projection){
+		return (projection.project(x, y, z));
+	}, _selectedProjection));
+}
+
 /**
  * @brief Sets the active projection type based on the provided type identifier.
  * 
@@ -69,44 +71,45 @@ IProjection *Projector::getProjection(){
 void Projector::setType(int type){
 	switch (type){
 		case 1:
-			_selectedProjection = _isometric;
+			_selectedProjection = IsometricProjection();
 			break;
 		case 2:
-			_selectedProjection = _perspective;
+			_selectedProjection = PerspectiveProjection();
 			break;
 		case 3:
-			_selectedProjection = _orthographic;
+			_selectedProjection = OrthographicProjection();
 			break;
 		case 4:
-			_selectedProjection = _trimetric;
+			_selectedProjection = TrimetricProjection();
 			break;
 		case 5:
-			_selectedProjection = _dimetric;
+			_selectedProjection = DimetricProjection();
 			break;
 		case 6:
-			_selectedProjection = _cabinet;
+			_selectedProjection = CabinetProjection();
 			break;
 		case 7:
-			_selectedProjection = _cavalier;
+			_selectedProjection = CavalierProjection();
 			break;
 		case 8:
-			_selectedProjection = _military;
+			_selectedProjection = MilitaryProjection();
 			break;
 		case 9:
-			_selectedProjection = _recursive;
+			_selectedProjection = RecursiveDepth();
 			break;
 		case 10:
-			_selectedProjection = _hyperbolic;
+			_selectedProjection = HyperbolicProjection();
 			break;
 		case 11:
-			_selectedProjection = _conic;
+			_selectedProjection = ConicProjection();
 			break;
 		case 12:
-			_selectedProjection = _spherical;
+			_selectedProjection = SphericalConicProjection();
 			break;
 		default:
 			throw(BadProjectionException());
 	}
+	_type = type;
 }
 
 /**